@@ -0,0 +1,825 @@
+#ifndef BTREE_HPP
+#define BTREE_HPP
+
+#include <functional>
+#include <memory>
+#include "vector.hpp"
+#include "iterator.hpp"
+#include "utility.hpp"
+#include "pool_allocator.hpp"
+
+namespace ft {
+
+	/*
+	** A B-tree node holds up to capacity values in order, as many as fit in
+	** about 256 bytes, so a lookup touches one node per level instead of one
+	** per comparison. The values live in raw storage and are built and
+	** destroyed one slot at a time, internal nodes add capacity + 1 children.
+	*/
+	template <class T>
+	struct btree_node {
+
+		static const size_t target_size = 256;
+		static const size_t header_size = sizeof( void* ) + 2 * sizeof( unsigned short ) + sizeof( bool );
+		static const size_t fitting = ( target_size - header_size ) / sizeof( T );
+		static const size_t capacity = fitting > 3 ? fitting : 3;
+		// every node but the root keeps at least that many values
+		static const size_t min_count = ( capacity - 1 ) / 2;
+
+		btree_node*		parent;
+		unsigned short	position;		// index among the children of parent
+		unsigned short	count;
+		bool			leaf;
+
+		T& value( size_t i ) {
+			return reinterpret_cast< T* >( _storage.bytes )[i];
+		}
+
+		const T& value( size_t i ) const {
+			return reinterpret_cast< const T* >( _storage.bytes )[i];
+		}
+
+		btree_node*& child( size_t i );
+		btree_node* child( size_t i ) const;
+
+		private:
+
+			union {
+				char		bytes[ capacity * sizeof( T ) ];
+				long double	align_float;
+				long		align_long;
+				void*		align_pointer;
+			} _storage;
+
+	};
+
+	template <class T>
+	struct btree_internal : public btree_node< T > {
+
+		btree_node< T >* children[ btree_node< T >::capacity + 1 ];
+
+	};
+
+	template <class T>
+	btree_node< T >*& btree_node< T >::child( size_t i ) {
+		return static_cast< btree_internal< T >* >( this )->children[i];
+	}
+
+	template <class T>
+	btree_node< T >* btree_node< T >::child( size_t i ) const {
+		return static_cast< const btree_internal< T >* >( this )->children[i];
+	}
+
+	// In-order successor of the value at pos, end() ( root, root->count ) wraps around to begin().
+	template <class T>
+	void btree_increment( btree_node< T >*& node, int& pos ) {
+		if ( pos == node->count ) {
+			while ( !node->leaf )
+				node = node->child( 0 );
+			pos = 0;
+			return ;
+		}
+		if ( !node->leaf ) {
+			node = node->child( pos + 1 );
+			while ( !node->leaf )
+				node = node->child( 0 );
+			pos = 0;
+			return ;
+		}
+		pos++;
+		while ( pos == node->count && node->parent ) {
+			pos = node->position;
+			node = node->parent;
+		}
+	}
+
+	// In-order predecessor of the value at pos, begin() goes back to end().
+	template <class T>
+	void btree_decrement( btree_node< T >*& node, int& pos ) {
+		if ( !node->leaf ) {
+			node = node->child( pos );
+			while ( !node->leaf )
+				node = node->child( node->count );
+			pos = node->count - 1;
+			return ;
+		}
+		pos--;
+		while ( pos < 0 && node->parent ) {
+			pos = node->position - 1;
+			node = node->parent;
+		}
+		if ( pos < 0 )
+			pos = node->count;
+	}
+
+	template < class T, class Container >
+	class btree_iterator {
+
+		public:
+
+			typedef ft::bidirectional_iterator_tag					iterator_category;
+			typedef std::ptrdiff_t									difference_type;
+			typedef T												value_type;
+			typedef T*												pointer;
+			typedef T&												reference;
+			typedef Container const									container_type;
+			typedef container_type*									container_pointer;
+
+			/************************* Constructors and Destructor ***************************/
+
+			btree_iterator( void ) : _node( NULL ), _pos( 0 ) {}
+			btree_iterator( btree_node< T >* node, int pos ) : _node( node ), _pos( pos ) {}
+			btree_iterator( btree_iterator const & cpy ) {
+				*this = cpy;
+			}
+			~btree_iterator( void ) {}
+
+			/************************* Member Functions **************************************/
+
+			btree_node< T >* getNode( void ) const {
+				return _node;
+			}
+
+			int getPosition( void ) const {
+				return _pos;
+			}
+
+			/************************* Implement operators ***********************************/
+
+			btree_iterator& operator=( btree_iterator const & rhs ) {
+				_node = rhs._node;
+				_pos = rhs._pos;
+				return *this;
+			}
+
+			reference operator*( void ) const {
+				return _node->value( _pos );
+			}
+
+			pointer operator->( void ) const {
+				return &_node->value( _pos );
+			}
+
+			btree_iterator& operator++( void ) {
+				btree_increment( _node, _pos );
+				return *this;
+			}
+
+			btree_iterator operator++( int ) {
+				btree_iterator tmp = *this;
+				++( *this );
+				return tmp;
+			}
+
+			btree_iterator& operator--( void ) {
+				btree_decrement( _node, _pos );
+				return *this;
+			}
+
+			btree_iterator operator--( int ) {
+				btree_iterator tmp = *this;
+				--( *this );
+				return tmp;
+			}
+
+		private:
+
+			btree_node< T >*	_node;
+			int					_pos;
+
+	};
+
+	template < class T, class Container >
+	class const_btree_iterator {
+
+		public:
+
+			typedef ft::bidirectional_iterator_tag					iterator_category;
+			typedef std::ptrdiff_t									difference_type;
+			typedef T												value_type;
+			typedef T*												pointer;
+			typedef T&												reference;
+			typedef T const *										const_pointer;
+			typedef T const &										const_reference;
+			typedef Container const									container_type;
+			typedef container_type *								container_pointer;
+
+			/************************* Constructors and Destructor ***************************/
+
+			const_btree_iterator( void ) : _node( NULL ), _pos( 0 ) {}
+			const_btree_iterator( btree_node< T >* node, int pos ) : _node( node ), _pos( pos ) {}
+			const_btree_iterator( btree_iterator<T, Container> const & it ) : _node( it.getNode() ), _pos( it.getPosition() ) {}
+			const_btree_iterator( const_btree_iterator const & copy ) {
+				*this = copy;
+			}
+			~const_btree_iterator( void ) {}
+
+			/************************* Member Functions **************************************/
+
+			btree_node< T >* getNode( void ) const {
+				return _node;
+			}
+
+			int getPosition( void ) const {
+				return _pos;
+			}
+
+			/************************* Implement operators ***********************************/
+
+			const_btree_iterator& operator=( const_btree_iterator const & rhs ) {
+				_node = rhs._node;
+				_pos = rhs._pos;
+				return *this;
+			}
+
+			const_reference operator*( void ) const {
+				return _node->value( _pos );
+			}
+
+			const_pointer operator->( void ) const {
+				return &_node->value( _pos );
+			}
+
+			const_btree_iterator& operator++( void ) {
+				btree_increment( _node, _pos );
+				return *this;
+			}
+			const_btree_iterator operator++( int ) {
+				const_btree_iterator tmp = *this;
+				++( *this );
+				return tmp;
+			}
+			const_btree_iterator& operator--( void ) {
+				btree_decrement( _node, _pos );
+				return *this;
+			}
+			const_btree_iterator operator--( int ) {
+				const_btree_iterator tmp = *this;
+				--( *this );
+				return tmp;
+			}
+
+		private:
+
+			btree_node< T >*	_node;
+			int					_pos;
+
+	};
+
+	template <class T, class Container>
+	bool operator==( btree_iterator<T, Container> const & lhs, btree_iterator<T, Container> const & rhs ) {
+		return lhs.getNode() == rhs.getNode() && lhs.getPosition() == rhs.getPosition();
+	}
+	template <class T, class Container>
+	bool operator!=( btree_iterator<T, Container> const & lhs, btree_iterator<T, Container> const & rhs ) {
+		return !( lhs == rhs );
+	}
+
+	template <class T, class Container>
+	bool operator==( const_btree_iterator<T, Container> const & lhs, const_btree_iterator<T, Container> const & rhs ) {
+		return lhs.getNode() == rhs.getNode() && lhs.getPosition() == rhs.getPosition();
+	}
+	template <class T, class Container>
+	bool operator!=( const_btree_iterator<T, Container> const & lhs, const_btree_iterator<T, Container> const & rhs ) {
+		return !( lhs == rhs );
+	}
+
+	/*
+	** Values are kept in order by value_comp, like ft::tree, but any insert
+	** or erase may move values between nodes: unlike the red-black tree it
+	** invalidates every iterator. erase returns the next one instead.
+	*/
+	template < class T, class value_comp = std::less<T>, class Alloc = std::allocator< T > >
+	class btree {
+
+		private:
+
+			typedef btree_node< T >														node_type;
+			typedef btree_internal< T >													internal_type;
+			typedef typename Alloc::template rebind< node_type >::other					leaf_alloc;
+			typedef typename Alloc::template rebind< internal_type >::other				internal_alloc;
+
+			static const size_t capacity = node_type::capacity;
+			static const size_t min_count = node_type::min_count;
+
+			node_type* _root;
+			size_t _size;
+			Alloc _allocator;
+			leaf_alloc _leaves;
+			internal_alloc _internals;
+			value_comp _comparer;
+
+		public:
+
+			typedef btree_iterator< T, btree< T, value_comp, Alloc > >				iterator;
+			typedef const_btree_iterator< T, btree< T, value_comp, Alloc > >		const_iterator;
+			typedef ft::reverse_iterator<iterator>									reverse_iterator;
+			typedef ft::const_reverse_iterator<const_iterator>						const_reverse_iterator;
+
+			btree( const value_comp& comp, const Alloc& alloc )
+			: _root( NULL ), _size( 0 ), _allocator( alloc ), _leaves( alloc ), _internals( alloc ), _comparer( comp ) {}
+
+			// sorted input is appended to the last leaf without any search
+			template <class InputIterator>
+			btree( InputIterator first, InputIterator last, const value_comp& comp, const Alloc& alloc )
+			: _root( NULL ), _size( 0 ), _allocator( alloc ), _leaves( alloc ), _internals( alloc ), _comparer( comp ) {
+				bool duplicate;
+				for ( ; first != last; first++ )
+					hint_add( end(), *first, &duplicate );
+			}
+
+			btree( const btree& x ) : _root( NULL ), _size( 0 ) {
+				*this = x;
+			}
+
+			~btree( void ) {
+				clear( _root );
+			}
+
+			btree& operator=( const btree& x ) {
+				if ( this == &x )
+					return *this;
+				clear();
+				_comparer = x._comparer;
+				_allocator = x._allocator;
+				_leaves = x._leaves;
+				_internals = x._internals;
+				if ( x._root )
+					_root = clone( x._root, NULL );
+				_size = x._size;
+				return *this;
+			}
+
+			iterator begin( void ) {
+				return iterator( leftmost(), 0 );
+			}
+
+			const_iterator begin( void ) const {
+				return const_iterator( leftmost(), 0 );
+			}
+
+			iterator end( void ) {
+				return iterator( _root, _root ? _root->count : 0 );
+			}
+
+			const_iterator end( void ) const {
+				return const_iterator( _root, _root ? _root->count : 0 );
+			}
+
+			reverse_iterator rbegin( void ) {
+				if ( _root == NULL )
+					return rend();
+				return reverse_iterator( --end() );
+			}
+
+			const_reverse_iterator rbegin( void ) const {
+				if ( _root == NULL )
+					return rend();
+				return const_reverse_iterator( --end() );
+			}
+
+			reverse_iterator rend( void ) {
+				return reverse_iterator( end() );
+			}
+
+			const_reverse_iterator rend( void ) const {
+				return const_reverse_iterator( end() );
+			}
+
+			size_t getSize( void ) const {
+				return _size;
+			}
+
+			Alloc getAllocator( void ) const {
+				return _allocator;
+			}
+
+			// nothing is built when p is already there
+			iterator add( T const & p, bool* duplicate ) {
+				iterator slot;
+				if ( find_slot( p, _comparer, &slot ) ) {
+					*duplicate = true;
+					return slot;
+				}
+				return add_at( slot, p );
+			}
+
+			/*
+			** O(1) when p goes right before hint: in the leaf of hint, or after
+			** its predecessor which is always in a leaf. Appending sorted values
+			** with end() as the hint never searches.
+			*/
+			iterator hint_add( iterator hint, T const & p, bool* duplicate ) {
+				if ( _size && ( hint == end() || _comparer( p, *hint ) ) ) {
+					iterator prev = hint;
+					if ( hint == begin() || _comparer( *--prev, p ) ) {
+						if ( hint != end() && hint.getNode()->leaf )
+							return add_at( hint, p );
+						return add_at( iterator( prev.getNode(), prev.getPosition() + 1 ), p );
+					}
+				}
+				return add( p, duplicate );
+			}
+
+			/*
+			** Returns true and the value equal to key, or false and the leaf
+			** slot where a value for key would be inserted by add_at.
+			** As for ft::tree, comp( value, key ) and comp( key, value ) must
+			** both work.
+			*/
+			template <class K, class Comp>
+			bool find_slot( K const & key, Comp comp, iterator* slot ) const {
+				node_type* node = _root;
+				int pos = 0;
+				while ( node ) {
+					pos = lower_index( node, key, comp );
+					if ( pos < node->count && !comp( key, node->value( pos ) ) ) {
+						*slot = iterator( node, pos );
+						return true;
+					}
+					if ( node->leaf )
+						break ;
+					node = node->child( pos );
+				}
+				*slot = iterator( node, pos );
+				return false;
+			}
+
+			iterator add_at( iterator slot, T const & p ) {
+				node_type* node = slot.getNode();
+				int pos = slot.getPosition();
+				if ( node == NULL ) {
+					_root = create_node( true );
+					node = _root;
+				}
+				else if ( node->count == capacity ) {
+					split( node );
+					if ( pos > static_cast< int >( capacity / 2 ) ) {
+						pos -= capacity / 2 + 1;
+						node = node->parent->child( node->position + 1 );
+					}
+				}
+				for ( int i = node->count; i > pos; i-- )
+					move_value( &node->value( i ), &node->value( i - 1 ) );
+				_allocator.construct( &node->value( pos ), p );
+				node->count++;
+				_size++;
+				return iterator( node, pos );
+			}
+
+			template <class K, class Comp>
+			iterator search( K const & key, Comp comp ) const {
+				iterator slot;
+				if ( find_slot( key, comp, &slot ) )
+					return slot;
+				return const_cast< btree* >( this )->end();
+			}
+
+			// first value not less than key
+			template <class K, class Comp>
+			iterator lower_search( K const & key, Comp comp ) const {
+				iterator res = past_end();
+				for ( node_type* node = _root; node; ) {
+					int pos = lower_index( node, key, comp );
+					if ( pos < node->count )
+						res = iterator( node, pos );
+					node = node->leaf ? NULL : node->child( pos );
+				}
+				return res;
+			}
+
+			// first value greater than key
+			template <class K, class Comp>
+			iterator upper_search( K const & key, Comp comp ) const {
+				iterator res = past_end();
+				for ( node_type* node = _root; node; ) {
+					int pos = upper_index( node, key, comp );
+					if ( pos < node->count )
+						res = iterator( node, pos );
+					node = node->leaf ? NULL : node->child( pos );
+				}
+				return res;
+			}
+
+			/*
+			** Erases the value at it and returns the iterator to the next one.
+			** A value of an internal node is replaced by its predecessor, taken
+			** from a leaf, then leaves that get too small borrow from a sibling
+			** or are merged with it up the tree. The predecessor of the erased
+			** value is followed through these moves to find the next one.
+			*/
+			iterator del( iterator it ) {
+				node_type* node = it.getNode();
+				int pos = it.getPosition();
+				iterator prev = it;
+				bool first = false;
+				if ( !node->leaf ) {
+					node_type* leaf = node->child( pos );
+					while ( !leaf->leaf )
+						leaf = leaf->child( leaf->count );
+					_allocator.destroy( &node->value( pos ) );
+					move_value( &node->value( pos ), &leaf->value( leaf->count - 1 ) );
+					leaf->count--;
+					node = leaf;
+				}
+				else {
+					--prev;
+					first = ( prev.getPosition() == prev.getNode()->count );
+					_allocator.destroy( &node->value( pos ) );
+					for ( int i = pos + 1; i < node->count; i++ )
+						move_value( &node->value( i - 1 ), &node->value( i ) );
+					node->count--;
+				}
+				_size--;
+				rebalance( node, &prev );
+				if ( first )
+					return begin();
+				return ++prev;
+			}
+
+			/*
+			** One del per value, O(k log n). Values move between nodes while
+			** others are erased, so last is not followed: the loop stops at
+			** the end or at a copy of the value of last. A map copies only the
+			** key of last and calls del_before itself.
+			*/
+			void del_range( iterator first, iterator last ) {
+				if ( first == begin() && last == end() )
+					return clear();
+				if ( last == end() ) {
+					while ( first != end() )
+						first = del( first );
+					return ;
+				}
+				T bound( *last );
+				del_before( first, bound, _comparer );
+			}
+
+			// erases from first while comp orders the value before bound, O(k log n)
+			template <class K, class Comp>
+			void del_before( iterator first, const K& bound, const Comp& comp ) {
+				while ( comp( *first, bound ) )
+					first = del( first );
+			}
+
+			void clear( void ) {
+				clear( _root );
+				_root = NULL;
+				_size = 0;
+				release_allocator( _leaves );
+				release_allocator( _internals );
+			}
+
+			void swap( btree & x ) {
+				node_type* r = _root;
+				size_t s = _size;
+				Alloc a = _allocator;
+				leaf_alloc l = _leaves;
+				internal_alloc i = _internals;
+				value_comp v = _comparer;
+				_root = x._root;
+				_size = x._size;
+				_allocator = x._allocator;
+				_leaves = x._leaves;
+				_internals = x._internals;
+				_comparer = x._comparer;
+				x._root = r;
+				x._size = s;
+				x._allocator = a;
+				x._leaves = l;
+				x._internals = i;
+				x._comparer = v;
+			}
+
+		private:
+
+			iterator past_end( void ) const {
+				return iterator( _root, _root ? _root->count : 0 );
+			}
+
+			node_type* leftmost( void ) const {
+				node_type* node = _root;
+				while ( node && !node->leaf )
+					node = node->child( 0 );
+				return node;
+			}
+
+			// index of the first value of node not less than key
+			template <class K, class Comp>
+			static int lower_index( const node_type* node, K const & key, Comp comp ) {
+				int low = 0;
+				int high = node->count;
+				while ( low < high ) {
+					int mid = ( low + high ) / 2;
+					if ( comp( node->value( mid ), key ) )
+						low = mid + 1;
+					else
+						high = mid;
+				}
+				return low;
+			}
+
+			// index of the first value of node greater than key
+			template <class K, class Comp>
+			static int upper_index( const node_type* node, K const & key, Comp comp ) {
+				int low = 0;
+				int high = node->count;
+				while ( low < high ) {
+					int mid = ( low + high ) / 2;
+					if ( comp( key, node->value( mid ) ) )
+						high = mid;
+					else
+						low = mid + 1;
+				}
+				return low;
+			}
+
+			node_type* create_node( bool leaf ) {
+				node_type* node;
+				if ( leaf )
+					node = _leaves.allocate( 1 );
+				else
+					node = _internals.allocate( 1 );
+				node->parent = NULL;
+				node->position = 0;
+				node->count = 0;
+				node->leaf = leaf;
+				return node;
+			}
+
+			void free_node( node_type* node ) {
+				if ( node->leaf )
+					_leaves.deallocate( node, 1 );
+				else
+					_internals.deallocate( static_cast< internal_type* >( node ), 1 );
+			}
+
+			// builds dst from src and destroys src
+			void move_value( T* dst, T* src ) {
+				_allocator.construct( dst, *src );
+				_allocator.destroy( src );
+			}
+
+			static void set_child( node_type* node, size_t i, node_type* child ) {
+				node->child( i ) = child;
+				child->parent = node;
+				child->position = i;
+			}
+
+			/*
+			** Splits a full node around its middle value, which moves up into
+			** the parent. A full parent is split first, a new root is made when
+			** node is the root.
+			*/
+			void split( node_type* node ) {
+				size_t mid = capacity / 2;
+				if ( node->parent == NULL ) {
+					_root = create_node( false );
+					set_child( _root, 0, node );
+				}
+				else if ( node->parent->count == capacity )
+					split( node->parent );
+				node_type* parent = node->parent;
+				node_type* sibling = create_node( node->leaf );
+				for ( size_t i = mid + 1; i < node->count; i++ )
+					move_value( &sibling->value( i - mid - 1 ), &node->value( i ) );
+				if ( !node->leaf )
+					for ( size_t i = mid + 1; i <= node->count; i++ )
+						set_child( sibling, i - mid - 1, node->child( i ) );
+				sibling->count = node->count - mid - 1;
+				for ( size_t i = parent->count; i > node->position; i-- ) {
+					move_value( &parent->value( i ), &parent->value( i - 1 ) );
+					set_child( parent, i + 1, parent->child( i ) );
+				}
+				move_value( &parent->value( node->position ), &node->value( mid ) );
+				set_child( parent, node->position + 1, sibling );
+				parent->count++;
+				node->count = mid;
+			}
+
+			void rebalance( node_type* node, iterator* track ) {
+				while ( node != _root && node->count < min_count ) {
+					node_type* parent = node->parent;
+					size_t i = node->position;
+					node_type* left = ( i > 0 ) ? parent->child( i - 1 ) : NULL;
+					node_type* right = ( i < parent->count ) ? parent->child( i + 1 ) : NULL;
+					if ( left && left->count > min_count )
+						return rotate_right( left, node, track );
+					if ( right && right->count > min_count )
+						return rotate_left( node, right, track );
+					if ( left )
+						merge( left, node, track );
+					else
+						merge( node, right, track );
+					node = parent;
+				}
+				if ( _root->count == 0 ) {
+					node_type* old = _root;
+					_root = _root->leaf ? NULL : _root->child( 0 );
+					if ( _root )
+						_root->parent = NULL;
+					free_node( old );
+				}
+			}
+
+			// moves the last value of left up into the parent and the separator down into right
+			void rotate_right( node_type* left, node_type* right, iterator* track ) {
+				node_type* parent = right->parent;
+				size_t i = left->position;
+				if ( track->getNode() == right )
+					*track = iterator( right, track->getPosition() + 1 );
+				else if ( track->getNode() == parent && track->getPosition() == static_cast< int >( i ) )
+					*track = iterator( right, 0 );
+				else if ( track->getNode() == left && track->getPosition() == left->count - 1 )
+					*track = iterator( parent, i );
+				for ( size_t j = right->count; j > 0; j-- )
+					move_value( &right->value( j ), &right->value( j - 1 ) );
+				move_value( &right->value( 0 ), &parent->value( i ) );
+				move_value( &parent->value( i ), &left->value( left->count - 1 ) );
+				if ( !right->leaf ) {
+					for ( size_t j = right->count + 1; j > 0; j-- )
+						set_child( right, j, right->child( j - 1 ) );
+					set_child( right, 0, left->child( left->count ) );
+				}
+				left->count--;
+				right->count++;
+			}
+
+			// moves the first value of right up into the parent and the separator down into left
+			void rotate_left( node_type* left, node_type* right, iterator* track ) {
+				node_type* parent = left->parent;
+				size_t i = left->position;
+				if ( track->getNode() == parent && track->getPosition() == static_cast< int >( i ) )
+					*track = iterator( left, left->count );
+				else if ( track->getNode() == right && track->getPosition() == 0 )
+					*track = iterator( parent, i );
+				else if ( track->getNode() == right )
+					*track = iterator( right, track->getPosition() - 1 );
+				move_value( &left->value( left->count ), &parent->value( i ) );
+				move_value( &parent->value( i ), &right->value( 0 ) );
+				for ( size_t j = 1; j < right->count; j++ )
+					move_value( &right->value( j - 1 ), &right->value( j ) );
+				if ( !left->leaf ) {
+					set_child( left, left->count + 1, right->child( 0 ) );
+					for ( size_t j = 1; j <= right->count; j++ )
+						set_child( right, j - 1, right->child( j ) );
+				}
+				left->count++;
+				right->count--;
+			}
+
+			// appends the separator and all of right to left, right is freed
+			void merge( node_type* left, node_type* right, iterator* track ) {
+				node_type* parent = left->parent;
+				size_t i = left->position;
+				size_t n = left->count;
+				if ( track->getNode() == parent && track->getPosition() == static_cast< int >( i ) )
+					*track = iterator( left, n );
+				else if ( track->getNode() == parent && track->getPosition() > static_cast< int >( i ) )
+					*track = iterator( parent, track->getPosition() - 1 );
+				else if ( track->getNode() == right )
+					*track = iterator( left, n + 1 + track->getPosition() );
+				move_value( &left->value( n ), &parent->value( i ) );
+				for ( size_t j = 0; j < right->count; j++ )
+					move_value( &left->value( n + 1 + j ), &right->value( j ) );
+				if ( !left->leaf )
+					for ( size_t j = 0; j <= right->count; j++ )
+						set_child( left, n + 1 + j, right->child( j ) );
+				left->count += right->count + 1;
+				for ( size_t j = i + 1; j < parent->count; j++ ) {
+					move_value( &parent->value( j - 1 ), &parent->value( j ) );
+					set_child( parent, j, parent->child( j + 1 ) );
+				}
+				parent->count--;
+				free_node( right );
+			}
+
+			node_type* clone( const node_type* node, node_type* parent ) {
+				node_type* res = create_node( node->leaf );
+				res->parent = parent;
+				res->position = node->position;
+				for ( size_t i = 0; i < node->count; i++ )
+					_allocator.construct( &res->value( i ), node->value( i ) );
+				res->count = node->count;
+				if ( !node->leaf )
+					for ( size_t i = 0; i <= node->count; i++ )
+						res->child( i ) = clone( node->child( i ), res );
+				return res;
+			}
+
+			void clear( node_type* node ) {
+				if ( node == NULL )
+					return ;
+				for ( size_t i = 0; i < node->count; i++ )
+					_allocator.destroy( &node->value( i ) );
+				if ( !node->leaf )
+					for ( size_t i = 0; i <= node->count; i++ )
+						clear( node->child( i ) );
+				free_node( node );
+			}
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,380 @@
+#ifndef BTREE_MAP_HPP
+#define BTREE_MAP_HPP
+
+#include "btree.hpp"
+
+namespace ft {
+
+	/*
+	** Same interface as ft::map on top of a B-tree: fewer cache misses per
+	** lookup and far less memory per element for small keys and values,
+	** but every insert or erase invalidates the iterators.
+	*/
+	template < class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator< pair< const Key, T > > >
+	class btree_map {
+
+		private:
+
+			class value_comp;
+
+		public:
+
+			/************************************* Typedefs ******************************************/
+
+			typedef Key																					key_type;
+			typedef T																					mapped_type;
+			typedef Compare																				key_compare;
+			typedef value_comp																			value_compare;
+			typedef pair< key_type, mapped_type >														value_type;
+			typedef Alloc																				allocator_type;
+			typedef typename allocator_type::template rebind< value_type >::other						value_alloc;
+			typedef typename allocator_type::reference													reference;
+			typedef typename allocator_type::const_reference											const_reference;
+			typedef typename allocator_type::pointer													pointer;
+			typedef typename allocator_type::const_pointer												const_pointer;
+			typedef btree_iterator< value_type, ft::btree< value_type, value_compare, value_alloc > >			iterator;
+			typedef const_btree_iterator< value_type, ft::btree< value_type, value_compare, value_alloc > >	const_iterator;
+			typedef reverse_iterator<iterator>															reverse_iterator;
+			typedef const_reverse_iterator<const_iterator>												const_reverse_iterator;
+			typedef std::ptrdiff_t																		difference_type;
+			typedef size_t																				size_type;
+
+		private:
+
+			key_compare _kcomparer;
+			value_compare _vcomparer;
+			allocator_type _allocator;
+			btree< value_type, value_compare, value_alloc > _tree;
+
+		public:
+
+			/************************************* Constructors **************************************/
+
+			explicit btree_map( const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type() )
+			: _kcomparer( comp ), _vcomparer( comp ), _allocator( alloc ), _tree( _vcomparer, alloc ) {}
+
+			template <class InputIterator>
+			btree_map( InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type() )
+			: _kcomparer( comp ), _vcomparer( comp ), _allocator( alloc ), _tree( first, last, _vcomparer, alloc ) {}
+
+			btree_map( const btree_map& x )
+			: _kcomparer( x._kcomparer ), _vcomparer( x._vcomparer ), _allocator( x._allocator ), _tree( x._tree ) {}
+
+			/************************************* Destructor ****************************************/
+
+			~btree_map( void ) {}
+
+			/************************************* Operator = ****************************************/
+
+			btree_map& operator=( const btree_map& x ) {
+				_tree = x._tree;
+				_vcomparer = x._vcomparer;
+				_kcomparer = x._kcomparer;
+				_allocator = x._allocator;
+				return *this;
+			}
+
+			/************************************* Iterators *****************************************/
+
+			iterator begin( void ) {
+				return _tree.begin();
+			}
+
+			const_iterator begin( void ) const {
+				return _tree.begin();
+			}
+
+			iterator end( void ) {
+				return _tree.end();
+			}
+
+			const_iterator end( void ) const {
+				return _tree.end();
+			}
+
+			reverse_iterator rbegin( void ) {
+				return _tree.rbegin();
+			}
+
+			const_reverse_iterator rbegin( void ) const {
+				return _tree.rbegin();
+			}
+
+			reverse_iterator rend( void ) {
+				return _tree.rend();
+			}
+
+			const_reverse_iterator rend( void ) const {
+				return _tree.rend();
+			}
+
+			/************************************* Capacity ******************************************/
+
+			bool empty( void ) const {
+				return ( _tree.getSize() == 0 ) ? true : false;
+			}
+
+			size_type size( void ) const {
+				return _tree.getSize();
+			}
+
+			size_type max_size( void ) const {
+				return _tree.getAllocator().max_size();
+			}
+
+			/************************************* Element access ************************************/
+
+			mapped_type& operator[]( const key_type& k ) {
+				return try_emplace( k ).first->second;
+			}
+
+			/************************************* Modifiers *****************************************/
+
+			pair<iterator, bool> insert( const value_type& val ) {
+				bool duplicate = false;
+				iterator it = _tree.add( val, &duplicate );
+				return ft::make_pair<iterator, bool>( it, !duplicate );
+			}
+
+			// constant time when val goes right before position
+			iterator insert( iterator position, const value_type& val ) {
+				bool duplicate = false;
+				return _tree.hint_add( position, val, &duplicate );
+			}
+
+			pair<iterator, bool> try_emplace( const key_type& k ) {
+				iterator slot;
+				if ( _tree.find_slot( k, key_value_comp<key_type>( _kcomparer ), &slot ) )
+					return ft::make_pair( slot, false );
+				return ft::make_pair( _tree.add_at( slot, value_type( k, mapped_type() ) ), true );
+			}
+
+			template <class M>
+			pair<iterator, bool> try_emplace( const key_type& k, const M& obj ) {
+				iterator slot;
+				if ( _tree.find_slot( k, key_value_comp<key_type>( _kcomparer ), &slot ) )
+					return ft::make_pair( slot, false );
+				return ft::make_pair( _tree.add_at( slot, value_type( k, obj ) ), true );
+			}
+
+			template <class M>
+			pair<iterator, bool> insert_or_assign( const key_type& k, const M& obj ) {
+				iterator slot;
+				if ( _tree.find_slot( k, key_value_comp<key_type>( _kcomparer ), &slot ) ) {
+					slot->second = obj;
+					return ft::make_pair( slot, false );
+				}
+				return ft::make_pair( _tree.add_at( slot, value_type( k, obj ) ), true );
+			}
+
+			// sorted input is appended to the last leaf without any search
+			template <class InputIterator>
+			void insert( InputIterator first, InputIterator last ) {
+				while ( first != last ) {
+					insert( end(), *first );
+					first++;
+				}
+			}
+
+			// returns the iterator to the next element, the others are invalidated
+			iterator erase( iterator position ) {
+				if ( position == end() )
+					return position;
+				return _tree.del( position );
+			}
+
+			size_type erase( const key_type& k ) {
+				iterator it = find_node( k );
+				if ( it != end() ) {
+					_tree.del( it );
+					return 1;
+				}
+				return 0;
+			}
+
+			void erase( iterator first, iterator last ) {
+				if ( last == end() )
+					return _tree.del_range( first, last );
+				key_type bound( last->first );
+				_tree.del_before( first, bound, key_value_comp<key_type>( _kcomparer ) );
+			}
+
+			void swap( btree_map& x ) {
+				_tree.swap( x._tree );
+			}
+
+			void clear( void ) {
+				_tree.clear();
+			}
+
+			/************************************* Observers *****************************************/
+
+			key_compare key_comp( void ) const {
+				return _kcomparer;
+			}
+
+			value_compare value_comp( void ) const {
+				return _vcomparer;
+			}
+
+			/************************************* Operations ****************************************/
+
+			iterator find( const key_type& k ) {
+				return find_node( k );
+			}
+
+			const_iterator find( const key_type& k ) const {
+				return find_node( k );
+			}
+
+			size_type count( const key_type& k ) const {
+				return find( k ) != end() ? 1 : 0;
+			}
+
+			iterator lower_bound( const key_type& k ) {
+				return lower_node( k );
+			}
+
+			const_iterator lower_bound( const key_type& k ) const {
+				return lower_node( k );
+			}
+
+			iterator upper_bound( const key_type& k ) {
+				return upper_node( k );
+			}
+
+			const_iterator upper_bound( const key_type& k ) const {
+				return upper_node( k );
+			}
+
+			pair<iterator,iterator> equal_range( const key_type& k ) {
+				return ft::make_pair( lower_bound( k ), upper_bound( k ) );
+			}
+
+			pair<const_iterator,const_iterator> equal_range( const key_type& k ) const {
+				return ft::make_pair( lower_bound( k ), upper_bound( k ) );
+			}
+
+			// lookups by another key type, with a transparent comparator as for ft::map
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type find( const K& k ) {
+				return find_node( k );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type find( const K& k ) const {
+				return find_node( k );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, size_type >::type count( const K& k ) const {
+				return find( k ) != end() ? 1 : 0;
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type lower_bound( const K& k ) {
+				return lower_node( k );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type lower_bound( const K& k ) const {
+				return lower_node( k );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type upper_bound( const K& k ) {
+				return upper_node( k );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type upper_bound( const K& k ) const {
+				return upper_node( k );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, pair<iterator,iterator> >::type equal_range( const K& k ) {
+				return ft::make_pair( lower_node( k ), upper_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, pair<const_iterator,const_iterator> >::type equal_range( const K& k ) const {
+				return ft::make_pair( const_iterator( lower_node( k ) ), const_iterator( upper_node( k ) ) );
+			}
+
+			/************************************* Allocator *****************************************/
+
+			allocator_type get_allocator( void ) const {
+				return _allocator;
+			}
+
+		private:
+
+			// orders a key of type K against the key of a value
+			template <class K>
+			class key_value_comp {
+
+				public:
+
+					key_value_comp( const key_compare& comp ) : _comp( comp ) {}
+
+					bool operator()( const value_type& x, const K& k ) const {
+						return _comp( x.first, k );
+					}
+
+					bool operator()( const K& k, const value_type& x ) const {
+						return _comp( k, x.first );
+					}
+
+				private:
+
+					key_compare _comp;
+
+			};
+
+			template <class K>
+			iterator find_node( const K& k ) const {
+				return _tree.search( k, key_value_comp<K>( _kcomparer ) );
+			}
+
+			template <class K>
+			iterator lower_node( const K& k ) const {
+				return _tree.lower_search( k, key_value_comp<K>( _kcomparer ) );
+			}
+
+			template <class K>
+			iterator upper_node( const K& k ) const {
+				return _tree.upper_search( k, key_value_comp<K>( _kcomparer ) );
+			}
+
+			class value_comp : std::binary_function< value_type, value_type, bool > {
+
+				friend class btree_map;
+
+			protected:
+
+				key_compare comp;
+				value_comp( key_compare c ) : comp( c ) {}
+
+			public:
+				value_comp( void ) {}
+
+				typedef bool 				result_type;
+				typedef value_type			first_argument_type;
+				typedef value_type			second_argument_type;
+				bool operator()( const value_type& x, const value_type& y ) const {
+					return comp( x.first, y.first );
+				}
+
+				value_comp& operator=( const value_comp& rhs ) {
+					comp = rhs.comp;
+					return *this;
+				}
+
+			};
+
+	};
+
+}
+
+#endif
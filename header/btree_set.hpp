@@ -0,0 +1,290 @@
+#ifndef BTREE_SET_HPP
+#define BTREE_SET_HPP
+
+#include "btree.hpp"
+
+namespace ft {
+
+	/*
+	** Same interface as ft::set on top of a B-tree: fewer cache misses per
+	** lookup and far less memory per element for small values, but every
+	** insert or erase invalidates the iterators.
+	*/
+	template < class T, class Compare = std::less<T>, class Alloc = std::allocator<T> >
+	class btree_set {
+
+		public:
+
+			/************************************* Typedefs ******************************************/
+
+			typedef T																					key_type;
+			typedef T																					value_type;
+			typedef Compare																				key_compare;
+			typedef Compare																				value_compare;
+			typedef Alloc																				allocator_type;
+			typedef typename allocator_type::reference													reference;
+			typedef typename allocator_type::const_reference											const_reference;
+			typedef typename allocator_type::pointer													pointer;
+			typedef typename allocator_type::const_pointer												const_pointer;
+			typedef btree_iterator< value_type, ft::btree< value_type, value_compare, allocator_type > >		iterator;
+			typedef const_btree_iterator< value_type, ft::btree< value_type, value_compare, allocator_type > >	const_iterator;
+			typedef reverse_iterator<iterator>															reverse_iterator;
+			typedef const_reverse_iterator<const_iterator>												const_reverse_iterator;
+			typedef std::ptrdiff_t																		difference_type;
+			typedef size_t																				size_type;
+
+		private:
+
+			key_compare _kcomparer;
+			allocator_type _allocator;
+			btree< value_type, value_compare, allocator_type > _tree;
+
+		public:
+
+			/************************************* Constructors **************************************/
+
+			explicit btree_set( const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type() )
+			: _kcomparer( comp ), _allocator( alloc ), _tree( comp, alloc ) {}
+
+			template <class InputIterator>
+			btree_set( InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type() )
+			: _kcomparer( comp ), _allocator( alloc ), _tree( first, last, comp, alloc ) {}
+
+			btree_set( const btree_set& x )
+			: _kcomparer( x._kcomparer ), _allocator( x._allocator ), _tree( x._tree ) {}
+
+			/************************************* Destructor ****************************************/
+
+			~btree_set( void ) {}
+
+			/************************************* Operator = ****************************************/
+
+			btree_set& operator=( const btree_set& x ) {
+				_tree = x._tree;
+				_kcomparer = x._kcomparer;
+				_allocator = x._allocator;
+				return *this;
+			}
+
+			/************************************* Iterators *****************************************/
+
+			iterator begin( void ) {
+				return _tree.begin();
+			}
+
+			const_iterator begin( void ) const {
+				return _tree.begin();
+			}
+
+			iterator end( void ) {
+				return _tree.end();
+			}
+
+			const_iterator end( void ) const {
+				return _tree.end();
+			}
+
+			reverse_iterator rbegin( void ) {
+				return _tree.rbegin();
+			}
+
+			const_reverse_iterator rbegin( void ) const {
+				return _tree.rbegin();
+			}
+
+			reverse_iterator rend( void ) {
+				return _tree.rend();
+			}
+
+			const_reverse_iterator rend( void ) const {
+				return _tree.rend();
+			}
+
+			/************************************* Capacity ******************************************/
+
+			bool empty( void ) const {
+				return ( _tree.getSize() == 0 ) ? true : false;
+			}
+
+			size_type size( void ) const {
+				return _tree.getSize();
+			}
+
+			size_type max_size( void ) const {
+				return _tree.getAllocator().max_size();
+			}
+
+			/************************************* Modifiers *****************************************/
+
+			pair<iterator, bool> insert( const value_type& val ) {
+				bool duplicate = false;
+				iterator it = _tree.add( val, &duplicate );
+				return ft::make_pair<iterator, bool>( it, !duplicate );
+			}
+
+			// constant time when val goes right before position
+			iterator insert( iterator position, const value_type& val ) {
+				bool duplicate = false;
+				return _tree.hint_add( position, val, &duplicate );
+			}
+
+			// sorted input is appended to the last leaf without any search
+			template <class InputIterator>
+			void insert( InputIterator first, InputIterator last ) {
+				while ( first != last ) {
+					insert( end(), *first );
+					first++;
+				}
+			}
+
+			// returns the iterator to the next element, the others are invalidated
+			iterator erase( iterator position ) {
+				if ( position == end() )
+					return position;
+				return _tree.del( position );
+			}
+
+			size_type erase( const value_type& val ) {
+				iterator it = find_node( val );
+				if ( it != end() ) {
+					_tree.del( it );
+					return 1;
+				}
+				return 0;
+			}
+
+			void erase( iterator first, iterator last ) {
+				_tree.del_range( first, last );
+			}
+
+			void swap( btree_set& x ) {
+				_tree.swap( x._tree );
+			}
+
+			void clear( void ) {
+				_tree.clear();
+			}
+
+			/************************************* Observers *****************************************/
+
+			key_compare key_comp( void ) const {
+				return _kcomparer;
+			}
+
+			value_compare value_comp( void ) const {
+				return _kcomparer;
+			}
+
+			/************************************* Operations ****************************************/
+
+			iterator find( const value_type& val ) {
+				return find_node( val );
+			}
+
+			const_iterator find( const value_type& val ) const {
+				return find_node( val );
+			}
+
+			size_type count( const value_type& val ) const {
+				return find( val ) != end() ? 1 : 0;
+			}
+
+			iterator lower_bound( const value_type& val ) {
+				return lower_node( val );
+			}
+
+			const_iterator lower_bound( const value_type& val ) const {
+				return lower_node( val );
+			}
+
+			iterator upper_bound( const value_type& val ) {
+				return upper_node( val );
+			}
+
+			const_iterator upper_bound( const value_type& val ) const {
+				return upper_node( val );
+			}
+
+			pair<iterator,iterator> equal_range( const value_type& val ) {
+				return ft::make_pair( lower_bound( val ), upper_bound( val ) );
+			}
+
+			pair<const_iterator,const_iterator> equal_range( const value_type& val ) const {
+				return ft::make_pair( lower_bound( val ), upper_bound( val ) );
+			}
+
+			// lookups by another key type, with a transparent comparator as for ft::set
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type find( const K& k ) {
+				return find_node( k );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type find( const K& k ) const {
+				return find_node( k );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, size_type >::type count( const K& k ) const {
+				return find( k ) != end() ? 1 : 0;
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type lower_bound( const K& k ) {
+				return lower_node( k );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type lower_bound( const K& k ) const {
+				return lower_node( k );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type upper_bound( const K& k ) {
+				return upper_node( k );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type upper_bound( const K& k ) const {
+				return upper_node( k );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, pair<iterator,iterator> >::type equal_range( const K& k ) {
+				return ft::make_pair( lower_node( k ), upper_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, pair<const_iterator,const_iterator> >::type equal_range( const K& k ) const {
+				return ft::make_pair( const_iterator( lower_node( k ) ), const_iterator( upper_node( k ) ) );
+			}
+
+			/************************************* Allocator *****************************************/
+
+			allocator_type get_allocator( void ) const {
+				return _allocator;
+			}
+
+		private:
+
+			template <class K>
+			iterator find_node( const K& k ) const {
+				return _tree.search( k, _kcomparer );
+			}
+
+			template <class K>
+			iterator lower_node( const K& k ) const {
+				return _tree.lower_search( k, _kcomparer );
+			}
+
+			template <class K>
+			iterator upper_node( const K& k ) const {
+				return _tree.upper_search( k, _kcomparer );
+			}
+
+	};
+
+}
+
+#endif
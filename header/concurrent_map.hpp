@@ -0,0 +1,326 @@
+#ifndef CONCURRENT_MAP_HPP
+#define CONCURRENT_MAP_HPP
+
+#include <pthread.h>
+#include <new>
+#include <stdexcept>
+#include "vector.hpp"
+#include "map.hpp"
+#include "hash.hpp"
+
+namespace ft {
+
+	/*
+	** Map shared between threads. Keys are spread by hash over a power of
+	** two number of ft::map shards, each behind its own reader-writer lock:
+	** lookups run in parallel and a writer only blocks the threads using
+	** the same shard. There are no iterators, values are copied in and out
+	** under the lock. The batch operations group their keys by shard and
+	** take each lock once.
+	*/
+	template < class Key, class T, class Hash = ft::hash<Key>, class Compare = std::less<Key>, class Alloc = std::allocator< pair< const Key, T > > >
+	class concurrent_map {
+
+		public:
+
+			/************************************* Typedefs ******************************************/
+
+			typedef Key																					key_type;
+			typedef T																					mapped_type;
+			typedef pair< key_type, mapped_type >														value_type;
+			typedef Hash																				hasher;
+			typedef Compare																				key_compare;
+			typedef Alloc																				allocator_type;
+			typedef ft::map< key_type, mapped_type, key_compare, allocator_type >						map_type;
+			typedef size_t																				size_type;
+
+		private:
+
+			static const size_type cache_line = 64;
+
+			struct shard {
+
+				pthread_rwlock_t	lock;
+				map_type			map;
+				char				pad[cache_line];	// keeps the locks of two shards off the same line
+
+				shard( const key_compare& comp, const allocator_type& alloc ) : map( comp, alloc ) {
+					if ( pthread_rwlock_init( &lock, NULL ) != 0 )
+						throw std::runtime_error( "concurrent_map: cannot create a lock" );
+				}
+
+				~shard( void ) {
+					pthread_rwlock_destroy( &lock );
+				}
+
+			};
+
+			class read_lock {
+
+				public:
+
+					explicit read_lock( shard& s ) : _lock( &s.lock ) {
+						pthread_rwlock_rdlock( _lock );
+					}
+
+					~read_lock( void ) {
+						pthread_rwlock_unlock( _lock );
+					}
+
+				private:
+
+					pthread_rwlock_t* _lock;
+
+			};
+
+			class write_lock {
+
+				public:
+
+					explicit write_lock( shard& s ) : _lock( &s.lock ) {
+						pthread_rwlock_wrlock( _lock );
+					}
+
+					~write_lock( void ) {
+						pthread_rwlock_unlock( _lock );
+					}
+
+				private:
+
+					pthread_rwlock_t* _lock;
+
+			};
+
+			shard* _shards;
+			size_type _count;
+			hasher _hasher;
+
+			// not copyable: the locks cannot be
+			concurrent_map( const concurrent_map& );
+			concurrent_map& operator=( const concurrent_map& );
+
+		public:
+
+			/************************************* Constructors **************************************/
+
+			// shards is rounded up to a power of two
+			explicit concurrent_map( size_type shards = 64, const hasher& hf = hasher(), const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type() )
+			: _shards( NULL ), _count( 1 ), _hasher( hf ) {
+				while ( _count < shards )
+					_count *= 2;
+				// each shard is built once, in place, with comp and alloc
+				_shards = static_cast< shard* >( ::operator new( _count * sizeof( shard ) ) );
+				size_type built = 0;
+				try {
+					for ( ; built < _count; built++ )
+						new ( static_cast< void* >( _shards + built ) ) shard( comp, alloc );
+				}
+				catch ( ... ) {
+					destroy( built );
+					throw ;
+				}
+			}
+
+			/************************************* Destructor ****************************************/
+
+			~concurrent_map( void ) {
+				destroy( _count );
+			}
+
+			/************************************* Capacity ******************************************/
+
+			// sums the shards one after the other, exact only while no thread writes
+			size_type size( void ) const {
+				size_type res = 0;
+				for ( size_type i = 0; i < _count; i++ ) {
+					read_lock guard( _shards[i] );
+					res += _shards[i].map.size();
+				}
+				return res;
+			}
+
+			bool empty( void ) const {
+				return size() == 0;
+			}
+
+			size_type shard_count( void ) const {
+				return _count;
+			}
+
+			/************************************* Modifiers *****************************************/
+
+			// false if the key was already there
+			bool insert( const value_type& val ) {
+				shard& s = shard_of( val.first );
+				write_lock guard( s );
+				return s.map.insert( val ).second;
+			}
+
+			// true if obj was inserted, false if it replaced the value of k
+			bool insert_or_assign( const key_type& k, const mapped_type& obj ) {
+				shard& s = shard_of( k );
+				write_lock guard( s );
+				return s.map.insert_or_assign( k, obj ).second;
+			}
+
+			// calls f on the value of k under the write lock, false if there is none
+			template <class Function>
+			bool update( const key_type& k, Function f ) {
+				shard& s = shard_of( k );
+				write_lock guard( s );
+				typename map_type::iterator it = s.map.find( k );
+				if ( it == s.map.end() )
+					return false;
+				f( it->second );
+				return true;
+			}
+
+			size_type erase( const key_type& k ) {
+				shard& s = shard_of( k );
+				write_lock guard( s );
+				return s.map.erase( k );
+			}
+
+			void clear( void ) {
+				for ( size_type i = 0; i < _count; i++ ) {
+					write_lock guard( _shards[i] );
+					_shards[i].map.clear();
+				}
+			}
+
+			/************************************* Operations ****************************************/
+
+			// copies the value of k into value, false if there is none
+			bool find( const key_type& k, mapped_type* value ) const {
+				shard& s = shard_of( k );
+				read_lock guard( s );
+				typename map_type::iterator it = s.map.find( k );
+				if ( it == s.map.end() )
+					return false;
+				*value = it->second;
+				return true;
+			}
+
+			size_type count( const key_type& k ) const {
+				shard& s = shard_of( k );
+				read_lock guard( s );
+				return s.map.count( k );
+			}
+
+			/************************************* Batches *******************************************/
+
+			// returns how many values were inserted
+			size_type insert_batch( const value_type* values, size_type n ) {
+				ft::vector< size_type > order;
+				ft::vector< size_type > bounds;
+				group( values, n, select_key(), &order, &bounds );
+				size_type res = 0;
+				for ( size_type i = 0; i < _count; i++ ) {
+					if ( bounds[i] == bounds[i + 1] )
+						continue ;
+					write_lock guard( _shards[i] );
+					for ( size_type j = bounds[i]; j < bounds[i + 1]; j++ )
+						res += _shards[i].map.insert( values[order[j]] ).second;
+				}
+				return res;
+			}
+
+			// found[i] tells if values[i] was set, returns how many were
+			size_type find_batch( const key_type* keys, size_type n, mapped_type* values, bool* found ) const {
+				ft::vector< size_type > order;
+				ft::vector< size_type > bounds;
+				group( keys, n, same_key(), &order, &bounds );
+				size_type res = 0;
+				for ( size_type i = 0; i < _count; i++ ) {
+					if ( bounds[i] == bounds[i + 1] )
+						continue ;
+					read_lock guard( _shards[i] );
+					for ( size_type j = bounds[i]; j < bounds[i + 1]; j++ ) {
+						size_type k = order[j];
+						typename map_type::iterator it = _shards[i].map.find( keys[k] );
+						found[k] = ( it != _shards[i].map.end() );
+						if ( found[k] ) {
+							values[k] = it->second;
+							res++;
+						}
+					}
+				}
+				return res;
+			}
+
+			// returns how many values were erased
+			size_type erase_batch( const key_type* keys, size_type n ) {
+				ft::vector< size_type > order;
+				ft::vector< size_type > bounds;
+				group( keys, n, same_key(), &order, &bounds );
+				size_type res = 0;
+				for ( size_type i = 0; i < _count; i++ ) {
+					if ( bounds[i] == bounds[i + 1] )
+						continue ;
+					write_lock guard( _shards[i] );
+					for ( size_type j = bounds[i]; j < bounds[i + 1]; j++ )
+						res += _shards[i].map.erase( keys[order[j]] );
+				}
+				return res;
+			}
+
+			/************************************* Observers *****************************************/
+
+			hasher hash_function( void ) const {
+				return _hasher;
+			}
+
+		private:
+
+			struct same_key {
+				const key_type& operator()( const key_type& k ) const {
+					return k;
+				}
+			};
+
+			struct select_key {
+				const key_type& operator()( const value_type& v ) const {
+					return v.first;
+				}
+			};
+
+			size_type shard_index( const key_type& k ) const {
+				return hash_mix( _hasher( k ) ) & ( _count - 1 );
+			}
+
+			shard& shard_of( const key_type& k ) const {
+				return _shards[shard_index( k )];
+			}
+
+			// destroys the first n shards and frees them all
+			void destroy( size_type n ) {
+				while ( n > 0 )
+					_shards[--n].~shard();
+				::operator delete( _shards );
+			}
+
+			/*
+			** Counting sort of the positions of items by shard: the items of
+			** shard i are at order[bounds[i]] up to order[bounds[i + 1]].
+			*/
+			template <class Item, class GetKey>
+			void group( const Item* items, size_type n, GetKey get_key, ft::vector< size_type >* order, ft::vector< size_type >* bounds ) const {
+				ft::vector< size_type > index( n );
+				bounds->assign( _count + 1, 0 );
+				for ( size_type i = 0; i < n; i++ ) {
+					index[i] = shard_index( get_key( items[i] ) );
+					( *bounds )[index[i] + 1]++;
+				}
+				for ( size_type i = 0; i < _count; i++ )
+					( *bounds )[i + 1] += ( *bounds )[i];
+				ft::vector< size_type > next( bounds->begin(), bounds->end() - 1 );
+				order->assign( n, 0 );
+				for ( size_type i = 0; i < n; i++ )
+					( *order )[next[index[i]]++] = i;
+			}
+
+	};
+
+}
+
+#endif
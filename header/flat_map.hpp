@@ -0,0 +1,773 @@
+#ifndef FLAT_MAP_HPP
+#define FLAT_MAP_HPP
+
+#include <functional>
+#include <memory>
+#include "vector.hpp"
+#include "utility.hpp"
+
+namespace ft {
+
+	// What a flat_map iterator points to: a key and its mapped value, both stored in place.
+	template <class Key, class T>
+	struct flat_map_reference {
+
+		const Key&	first;
+		T&			second;
+
+		flat_map_reference( const Key& k, T& v ) : first( k ), second( v ) {}
+
+		template <class U, class V>
+		operator pair<U, V>( void ) const {
+			return pair<U, V>( first, second );
+		}
+
+	};
+
+	// Result of operator-> on a flat_map iterator, keeps the reference alive for the member access.
+	template <class Key, class T>
+	struct flat_map_pointer {
+
+		flat_map_reference<Key, T> ref;
+
+		flat_map_pointer( const flat_map_reference<Key, T>& r ) : ref( r ) {}
+
+		const flat_map_reference<Key, T>* operator->( void ) const {
+			return &ref;
+		}
+
+	};
+
+	template < class Key, class T, class Keys, class Values >
+	class flat_map_iterator {
+
+		public:
+
+			typedef ft::random_access_iterator_tag					iterator_category;
+			typedef std::ptrdiff_t									difference_type;
+			typedef pair< Key, T >									value_type;
+			typedef flat_map_pointer< Key, T >						pointer;
+			typedef flat_map_reference< Key, T >					reference;
+			typedef Values											container_type;
+			typedef container_type*									container_pointer;
+
+			/************************* Constructors and Destructor ***************************/
+
+			flat_map_iterator( void ) : _keys( NULL ), _values( NULL ), _idx( 0 ) {}
+			flat_map_iterator( const Keys* keys, Values* values, long idx ) : _keys( keys ), _values( values ), _idx( idx ) {}
+			flat_map_iterator( flat_map_iterator const & cpy ) {
+				*this = cpy;
+			}
+			~flat_map_iterator( void ) {}
+
+			/************************* Member Functions **************************************/
+
+			const Keys* getKeys( void ) const {
+				return _keys;
+			}
+
+			Values* getValues( void ) const {
+				return _values;
+			}
+
+			long getIndex( void ) const {
+				return _idx;
+			}
+
+			/************************* Implement operators ***********************************/
+
+			flat_map_iterator& operator=( flat_map_iterator const & rhs ) {
+				_keys = rhs._keys;
+				_values = rhs._values;
+				_idx = rhs._idx;
+				return *this;
+			}
+			reference operator*( void ) const {
+				return reference( (*_keys)[_idx], (*_values)[_idx] );
+			}
+			pointer operator->( void ) const {
+				return pointer( **this );
+			}
+			flat_map_iterator& operator++( void ) {
+				_idx++;
+				return *this;
+			}
+			flat_map_iterator operator++( int ) {
+				flat_map_iterator tmp = *this;
+				++( *this );
+				return tmp;
+			}
+			flat_map_iterator& operator--( void ) {
+				_idx--;
+				return *this;
+			}
+			flat_map_iterator operator--( int ) {
+				flat_map_iterator tmp = *this;
+				--( *this );
+				return tmp;
+			}
+			flat_map_iterator operator+( difference_type n ) const {
+				return flat_map_iterator( _keys, _values, _idx + n );
+			}
+			flat_map_iterator operator-( difference_type n ) const {
+				return flat_map_iterator( _keys, _values, _idx - n );
+			}
+			flat_map_iterator& operator+=( difference_type n ) {
+				_idx += n;
+				return *this;
+			}
+			flat_map_iterator& operator-=( difference_type n ) {
+				_idx -= n;
+				return *this;
+			}
+			reference operator[]( difference_type index ) const {
+				return *( *this + index );
+			}
+
+		private:
+
+			const Keys*	_keys;
+			Values*		_values;
+			long		_idx;
+
+	};
+
+	template < class Key, class T, class Keys, class Values >
+	class const_flat_map_iterator {
+
+		public:
+
+			typedef ft::random_access_iterator_tag					iterator_category;
+			typedef std::ptrdiff_t									difference_type;
+			typedef pair< Key, T >									value_type;
+			typedef flat_map_pointer< Key, const T >				pointer;
+			typedef flat_map_reference< Key, const T >				reference;
+			typedef pointer											const_pointer;
+			typedef reference										const_reference;
+			typedef Values const									container_type;
+			typedef container_type*									container_pointer;
+
+			/************************* Constructors and Destructor ***************************/
+
+			const_flat_map_iterator( void ) : _keys( NULL ), _values( NULL ), _idx( 0 ) {}
+			const_flat_map_iterator( const Keys* keys, const Values* values, long idx ) : _keys( keys ), _values( values ), _idx( idx ) {}
+			const_flat_map_iterator( flat_map_iterator<Key, T, Keys, Values> const & it )
+			: _keys( it.getKeys() ), _values( it.getValues() ), _idx( it.getIndex() ) {}
+			const_flat_map_iterator( const_flat_map_iterator const & cpy ) {
+				*this = cpy;
+			}
+			~const_flat_map_iterator( void ) {}
+
+			/************************* Member Functions **************************************/
+
+			long getIndex( void ) const {
+				return _idx;
+			}
+
+			/************************* Implement operators ***********************************/
+
+			const_flat_map_iterator& operator=( const_flat_map_iterator const & rhs ) {
+				_keys = rhs._keys;
+				_values = rhs._values;
+				_idx = rhs._idx;
+				return *this;
+			}
+			const_reference operator*( void ) const {
+				return const_reference( (*_keys)[_idx], (*_values)[_idx] );
+			}
+			const_pointer operator->( void ) const {
+				return const_pointer( **this );
+			}
+			const_flat_map_iterator& operator++( void ) {
+				_idx++;
+				return *this;
+			}
+			const_flat_map_iterator operator++( int ) {
+				const_flat_map_iterator tmp = *this;
+				++( *this );
+				return tmp;
+			}
+			const_flat_map_iterator& operator--( void ) {
+				_idx--;
+				return *this;
+			}
+			const_flat_map_iterator operator--( int ) {
+				const_flat_map_iterator tmp = *this;
+				--( *this );
+				return tmp;
+			}
+			const_flat_map_iterator operator+( difference_type n ) const {
+				return const_flat_map_iterator( _keys, _values, _idx + n );
+			}
+			const_flat_map_iterator operator-( difference_type n ) const {
+				return const_flat_map_iterator( _keys, _values, _idx - n );
+			}
+			const_flat_map_iterator& operator+=( difference_type n ) {
+				_idx += n;
+				return *this;
+			}
+			const_flat_map_iterator& operator-=( difference_type n ) {
+				_idx -= n;
+				return *this;
+			}
+			const_reference operator[]( difference_type index ) const {
+				return *( *this + index );
+			}
+
+		private:
+
+			const Keys*		_keys;
+			const Values*	_values;
+			long			_idx;
+
+	};
+
+	/************************* Non member function operators *********************************/
+
+	template < class Key, class T, class Keys, class Values >
+	bool operator==( flat_map_iterator<Key, T, Keys, Values> const & lhs, flat_map_iterator<Key, T, Keys, Values> const & rhs ) {
+		return lhs.getIndex() == rhs.getIndex();
+	}
+	template < class Key, class T, class Keys, class Values >
+	bool operator!=( flat_map_iterator<Key, T, Keys, Values> const & lhs, flat_map_iterator<Key, T, Keys, Values> const & rhs ) {
+		return lhs.getIndex() != rhs.getIndex();
+	}
+	template < class Key, class T, class Keys, class Values >
+	bool operator<( flat_map_iterator<Key, T, Keys, Values> const & lhs, flat_map_iterator<Key, T, Keys, Values> const & rhs ) {
+		return lhs.getIndex() < rhs.getIndex();
+	}
+	template < class Key, class T, class Keys, class Values >
+	typename flat_map_iterator<Key, T, Keys, Values>::difference_type operator-( flat_map_iterator<Key, T, Keys, Values> const & lhs, flat_map_iterator<Key, T, Keys, Values> const & rhs ) {
+		return lhs.getIndex() - rhs.getIndex();
+	}
+
+	template < class Key, class T, class Keys, class Values >
+	bool operator==( const_flat_map_iterator<Key, T, Keys, Values> const & lhs, const_flat_map_iterator<Key, T, Keys, Values> const & rhs ) {
+		return lhs.getIndex() == rhs.getIndex();
+	}
+	template < class Key, class T, class Keys, class Values >
+	bool operator!=( const_flat_map_iterator<Key, T, Keys, Values> const & lhs, const_flat_map_iterator<Key, T, Keys, Values> const & rhs ) {
+		return lhs.getIndex() != rhs.getIndex();
+	}
+	template < class Key, class T, class Keys, class Values >
+	bool operator<( const_flat_map_iterator<Key, T, Keys, Values> const & lhs, const_flat_map_iterator<Key, T, Keys, Values> const & rhs ) {
+		return lhs.getIndex() < rhs.getIndex();
+	}
+	template < class Key, class T, class Keys, class Values >
+	typename const_flat_map_iterator<Key, T, Keys, Values>::difference_type operator-( const_flat_map_iterator<Key, T, Keys, Values> const & lhs, const_flat_map_iterator<Key, T, Keys, Values> const & rhs ) {
+		return lhs.getIndex() - rhs.getIndex();
+	}
+
+	/*
+	** Map interface over two sorted ft::vectors, one for the keys and one
+	** for the mapped values: lookups are binary searches over contiguous
+	** keys only. Inserting or erasing a single element is linear, so it
+	** suits maps that are built once, ideally in bulk, and then mostly read.
+	** Iterators dereference to a pair of references into both vectors and
+	** are invalidated by any insert or erase.
+	*/
+	template < class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator< pair< const Key, T > > >
+	class flat_map {
+
+		private:
+
+			class value_comp;
+
+		public:
+
+			/************************************* Typedefs ******************************************/
+
+			typedef Key																					key_type;
+			typedef T																					mapped_type;
+			typedef Compare																				key_compare;
+			typedef value_comp																			value_compare;
+			typedef pair< key_type, mapped_type >														value_type;
+			typedef Alloc																				allocator_type;
+			typedef typename allocator_type::template rebind< key_type >::other							key_alloc;
+			typedef typename allocator_type::template rebind< mapped_type >::other						mapped_alloc;
+			typedef ft::vector< key_type, key_alloc >													key_container_type;
+			typedef ft::vector< mapped_type, mapped_alloc >												mapped_container_type;
+			typedef flat_map_iterator< key_type, mapped_type, key_container_type, mapped_container_type >		iterator;
+			typedef const_flat_map_iterator< key_type, mapped_type, key_container_type, mapped_container_type >	const_iterator;
+			typedef reverse_iterator<iterator>															reverse_iterator;
+			typedef const_reverse_iterator<const_iterator>												const_reverse_iterator;
+			typedef typename iterator::reference														reference;
+			typedef typename const_iterator::reference													const_reference;
+			typedef typename iterator::pointer															pointer;
+			typedef typename const_iterator::pointer													const_pointer;
+			typedef std::ptrdiff_t																		difference_type;
+			typedef size_t																				size_type;
+
+		private:
+
+			key_compare _kcomparer;
+			allocator_type _allocator;
+			key_container_type _keys;
+			mapped_container_type _values;
+
+		public:
+
+			/************************************* Constructors **************************************/
+
+			explicit flat_map( const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type() )
+			: _kcomparer( comp ), _allocator( alloc ), _keys( key_alloc( alloc ) ), _values( mapped_alloc( alloc ) ) {}
+
+			template <class InputIterator>
+			flat_map( InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type() )
+			: _kcomparer( comp ), _allocator( alloc ), _keys( key_alloc( alloc ) ), _values( mapped_alloc( alloc ) ) {
+				insert( first, last );
+			}
+
+			flat_map( const flat_map& x )
+			: _kcomparer( x._kcomparer ), _allocator( x._allocator ), _keys( x._keys ), _values( x._values ) {}
+
+			/************************************* Destructor ****************************************/
+
+			~flat_map( void ) {}
+
+			/************************************* Operator = ****************************************/
+
+			flat_map& operator=( const flat_map& x ) {
+				_kcomparer = x._kcomparer;
+				_allocator = x._allocator;
+				_keys = x._keys;
+				_values = x._values;
+				return *this;
+			}
+
+			/************************************* Iterators *****************************************/
+
+			iterator begin( void ) {
+				return iterator( &_keys, &_values, 0 );
+			}
+
+			const_iterator begin( void ) const {
+				return const_iterator( &_keys, &_values, 0 );
+			}
+
+			iterator end( void ) {
+				return iterator( &_keys, &_values, size() );
+			}
+
+			const_iterator end( void ) const {
+				return const_iterator( &_keys, &_values, size() );
+			}
+
+			reverse_iterator rbegin( void ) {
+				return reverse_iterator( --end() );
+			}
+
+			const_reverse_iterator rbegin( void ) const {
+				return const_reverse_iterator( --end() );
+			}
+
+			reverse_iterator rend( void ) {
+				return reverse_iterator( --begin() );
+			}
+
+			const_reverse_iterator rend( void ) const {
+				return const_reverse_iterator( --begin() );
+			}
+
+			/************************************* Capacity ******************************************/
+
+			bool empty( void ) const {
+				return _keys.empty();
+			}
+
+			size_type size( void ) const {
+				return _keys.size();
+			}
+
+			size_type max_size( void ) const {
+				return _keys.max_size();
+			}
+
+			void reserve( size_type n ) {
+				_keys.reserve( n );
+				_values.reserve( n );
+			}
+
+			/************************************* Element access ************************************/
+
+			mapped_type& operator[]( const key_type& k ) {
+				size_type i = lower_index( k );
+				if ( i == size() || _kcomparer( k, _keys[i] ) )
+					insert_at( i, k, mapped_type() );
+				return _values[i];
+			}
+
+			/************************************* Modifiers *****************************************/
+
+			pair<iterator, bool> insert( const value_type& val ) {
+				size_type i = lower_index( val.first );
+				if ( i < size() && !_kcomparer( val.first, _keys[i] ) )
+					return ft::make_pair( to_iterator( i ), false );
+				insert_at( i, val.first, val.second );
+				return ft::make_pair( to_iterator( i ), true );
+			}
+
+			// no search when val goes right before position
+			iterator insert( iterator position, const value_type& val ) {
+				size_type i = position.getIndex();
+				if ( ( i == 0 || _kcomparer( _keys[i - 1], val.first ) ) && ( i == size() || _kcomparer( val.first, _keys[i] ) ) ) {
+					insert_at( i, val.first, val.second );
+					return to_iterator( i );
+				}
+				return insert( val ).first;
+			}
+
+			/*
+			** Appends the whole range, then sorts the new elements and merges
+			** them with the old ones in one pass. Nothing is sorted or merged
+			** when the range is ordered and goes after the current keys.
+			*/
+			template <class InputIterator>
+			void insert( InputIterator first, InputIterator last ) {
+				size_type old = size();
+				for ( ; first != last; first++ ) {
+					_keys.push_back( ( *first ).first );
+					_values.push_back( ( *first ).second );
+				}
+				merge_tail( old );
+			}
+
+			pair<iterator, bool> try_emplace( const key_type& k ) {
+				size_type i = lower_index( k );
+				if ( i < size() && !_kcomparer( k, _keys[i] ) )
+					return ft::make_pair( to_iterator( i ), false );
+				insert_at( i, k, mapped_type() );
+				return ft::make_pair( to_iterator( i ), true );
+			}
+
+			template <class M>
+			pair<iterator, bool> try_emplace( const key_type& k, const M& obj ) {
+				size_type i = lower_index( k );
+				if ( i < size() && !_kcomparer( k, _keys[i] ) )
+					return ft::make_pair( to_iterator( i ), false );
+				insert_at( i, k, obj );
+				return ft::make_pair( to_iterator( i ), true );
+			}
+
+			template <class M>
+			pair<iterator, bool> insert_or_assign( const key_type& k, const M& obj ) {
+				size_type i = lower_index( k );
+				if ( i < size() && !_kcomparer( k, _keys[i] ) ) {
+					_values[i] = obj;
+					return ft::make_pair( to_iterator( i ), false );
+				}
+				insert_at( i, k, obj );
+				return ft::make_pair( to_iterator( i ), true );
+			}
+
+			// returns the iterator to the next element, the others are invalidated
+			iterator erase( iterator position ) {
+				if ( position == end() )
+					return position;
+				erase_at( position.getIndex(), position.getIndex() + 1 );
+				return to_iterator( position.getIndex() );
+			}
+
+			size_type erase( const key_type& k ) {
+				size_type i = find_index( k );
+				if ( i == size() )
+					return 0;
+				erase_at( i, i + 1 );
+				return 1;
+			}
+
+			void erase( iterator first, iterator last ) {
+				erase_at( first.getIndex(), last.getIndex() );
+			}
+
+			void swap( flat_map& x ) {
+				key_compare comp = _kcomparer;
+				allocator_type alloc = _allocator;
+				_kcomparer = x._kcomparer;
+				_allocator = x._allocator;
+				x._kcomparer = comp;
+				x._allocator = alloc;
+				_keys.swap( x._keys );
+				_values.swap( x._values );
+			}
+
+			void clear( void ) {
+				_keys.clear();
+				_values.clear();
+			}
+
+			/************************************* Observers *****************************************/
+
+			key_compare key_comp( void ) const {
+				return _kcomparer;
+			}
+
+			value_compare value_comp( void ) const {
+				return value_compare( _kcomparer );
+			}
+
+			// the sorted keys and their mapped values, index by index
+			const key_container_type& keys( void ) const {
+				return _keys;
+			}
+
+			const mapped_container_type& values( void ) const {
+				return _values;
+			}
+
+			/************************************* Operations ****************************************/
+
+			iterator find( const key_type& k ) {
+				return to_iterator( find_index( k ) );
+			}
+
+			const_iterator find( const key_type& k ) const {
+				return to_iterator( find_index( k ) );
+			}
+
+			size_type count( const key_type& k ) const {
+				return find_index( k ) != size() ? 1 : 0;
+			}
+
+			iterator lower_bound( const key_type& k ) {
+				return to_iterator( lower_index( k ) );
+			}
+
+			const_iterator lower_bound( const key_type& k ) const {
+				return to_iterator( lower_index( k ) );
+			}
+
+			iterator upper_bound( const key_type& k ) {
+				return to_iterator( upper_index( k ) );
+			}
+
+			const_iterator upper_bound( const key_type& k ) const {
+				return to_iterator( upper_index( k ) );
+			}
+
+			pair<iterator,iterator> equal_range( const key_type& k ) {
+				return ft::make_pair( lower_bound( k ), upper_bound( k ) );
+			}
+
+			pair<const_iterator,const_iterator> equal_range( const key_type& k ) const {
+				return ft::make_pair( lower_bound( k ), upper_bound( k ) );
+			}
+
+			// lookups by another key type, with a transparent comparator as for ft::map
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type find( const K& k ) {
+				return to_iterator( find_index( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type find( const K& k ) const {
+				return to_iterator( find_index( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, size_type >::type count( const K& k ) const {
+				return find_index( k ) != size() ? 1 : 0;
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type lower_bound( const K& k ) {
+				return to_iterator( lower_index( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type lower_bound( const K& k ) const {
+				return to_iterator( lower_index( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type upper_bound( const K& k ) {
+				return to_iterator( upper_index( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type upper_bound( const K& k ) const {
+				return to_iterator( upper_index( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, pair<iterator,iterator> >::type equal_range( const K& k ) {
+				return ft::make_pair( to_iterator( lower_index( k ) ), to_iterator( upper_index( k ) ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, pair<const_iterator,const_iterator> >::type equal_range( const K& k ) const {
+				return ft::make_pair( to_iterator( lower_index( k ) ), to_iterator( upper_index( k ) ) );
+			}
+
+			/************************************* Allocator *****************************************/
+
+			allocator_type get_allocator( void ) const {
+				return _allocator;
+			}
+
+		private:
+
+			// orders two positions of the key vector
+			class index_comp {
+
+				public:
+
+					index_comp( const key_container_type& keys, const key_compare& comp ) : _keys( keys ), _comp( comp ) {}
+
+					bool operator()( size_type a, size_type b ) const {
+						return _comp( _keys[a], _keys[b] );
+					}
+
+				private:
+
+					const key_container_type& _keys;
+					key_compare _comp;
+
+			};
+
+			template <class K>
+			size_type lower_index( const K& k ) const {
+				size_type first = 0;
+				size_type len = size();
+				while ( len > 0 ) {
+					size_type half = len / 2;
+					if ( _kcomparer( _keys[first + half], k ) ) {
+						first += half + 1;
+						len -= half + 1;
+					}
+					else
+						len = half;
+				}
+				return first;
+			}
+
+			template <class K>
+			size_type upper_index( const K& k ) const {
+				size_type first = 0;
+				size_type len = size();
+				while ( len > 0 ) {
+					size_type half = len / 2;
+					if ( !_kcomparer( k, _keys[first + half] ) ) {
+						first += half + 1;
+						len -= half + 1;
+					}
+					else
+						len = half;
+				}
+				return first;
+			}
+
+			// index of k, size() when it is not there
+			template <class K>
+			size_type find_index( const K& k ) const {
+				size_type i = lower_index( k );
+				if ( i < size() && !_kcomparer( k, _keys[i] ) )
+					return i;
+				return size();
+			}
+
+			iterator to_iterator( size_type i ) {
+				return iterator( &_keys, &_values, i );
+			}
+
+			const_iterator to_iterator( size_type i ) const {
+				return const_iterator( &_keys, &_values, i );
+			}
+
+			// v is a copy, it may come from _values which can be reallocated
+			void insert_at( size_type i, const key_type& k, mapped_type v ) {
+				_keys.push_back( k );
+				_values.push_back( v );
+				for ( size_type j = size() - 1; j > i; j-- ) {
+					_keys[j] = _keys[j - 1];
+					_values[j] = _values[j - 1];
+				}
+				_keys[i] = k;
+				_values[i] = v;
+			}
+
+			void erase_at( size_type first, size_type last ) {
+				size_type n = last - first;
+				for ( size_type i = last; i < size(); i++ ) {
+					_keys[i - n] = _keys[i];
+					_values[i - n] = _values[i];
+				}
+				for ( size_type i = 0; i < n; i++ ) {
+					_keys.pop_back();
+					_values.pop_back();
+				}
+			}
+
+			/*
+			** Sorts the elements after the first old ones, stably so that the
+			** first of equal keys wins, then merges both runs into new vectors.
+			** Keys that were already there keep their value.
+			*/
+			void merge_tail( size_type old ) {
+				size_type n = size() - old;
+				size_type i = ( old > 0 ) ? old : 1;
+				while ( i < size() && _kcomparer( _keys[i - 1], _keys[i] ) )
+					i++;
+				if ( i >= size() )
+					return ;
+				ft::vector< size_type > order( n );
+				ft::vector< size_type > buffer( n );
+				for ( size_type j = 0; j < n; j++ )
+					order[j] = old + j;
+				ft::merge_sort( &order[0], &order[0] + n, &buffer[0], index_comp( _keys, _kcomparer ) );
+				key_container_type keys( _keys.get_allocator() );
+				mapped_container_type values( _values.get_allocator() );
+				keys.reserve( size() );
+				values.reserve( size() );
+				size_type j = 0;
+				i = 0;
+				while ( i < old || j < n ) {
+					if ( j == n || ( i < old && _kcomparer( _keys[i], _keys[order[j]] ) ) ) {
+						keys.push_back( _keys[i] );
+						values.push_back( _values[i++] );
+						continue ;
+					}
+					size_type k = order[j++];
+					if ( i < old && !_kcomparer( _keys[k], _keys[i] ) )
+						continue ;
+					if ( !keys.empty() && !_kcomparer( keys.back(), _keys[k] ) )
+						continue ;
+					keys.push_back( _keys[k] );
+					values.push_back( _values[k] );
+				}
+				_keys.swap( keys );
+				_values.swap( values );
+			}
+
+			class value_comp : std::binary_function< value_type, value_type, bool > {
+
+				friend class flat_map;
+
+			protected:
+
+				key_compare comp;
+				value_comp( key_compare c ) : comp( c ) {}
+
+			public:
+				value_comp( void ) {}
+
+				typedef bool 				result_type;
+				typedef value_type			first_argument_type;
+				typedef value_type			second_argument_type;
+				bool operator()( const value_type& x, const value_type& y ) const {
+					return comp( x.first, y.first );
+				}
+
+				value_comp& operator=( const value_comp& rhs ) {
+					comp = rhs.comp;
+					return *this;
+				}
+
+			};
+
+	};
+
+}
+
+#endif
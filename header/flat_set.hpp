@@ -0,0 +1,354 @@
+#ifndef FLAT_SET_HPP
+#define FLAT_SET_HPP
+
+#include <functional>
+#include <memory>
+#include "vector.hpp"
+#include "utility.hpp"
+
+namespace ft {
+
+	/*
+	** Set interface over one sorted ft::vector: binary search lookups over
+	** contiguous values, linear single inserts and erases. Best built once,
+	** in bulk, then mostly read. Any insert or erase invalidates iterators.
+	*/
+	template < class T, class Compare = std::less<T>, class Alloc = std::allocator<T> >
+	class flat_set {
+
+		public:
+
+			/************************************* Typedefs ******************************************/
+
+			typedef T																					key_type;
+			typedef T																					value_type;
+			typedef Compare																				key_compare;
+			typedef Compare																				value_compare;
+			typedef Alloc																				allocator_type;
+			typedef ft::vector< value_type, allocator_type >											container_type;
+			typedef typename allocator_type::reference													reference;
+			typedef typename allocator_type::const_reference											const_reference;
+			typedef typename allocator_type::pointer													pointer;
+			typedef typename allocator_type::const_pointer												const_pointer;
+			typedef typename container_type::const_iterator												iterator;
+			typedef typename container_type::const_iterator												const_iterator;
+			typedef typename container_type::const_reverse_iterator										reverse_iterator;
+			typedef typename container_type::const_reverse_iterator										const_reverse_iterator;
+			typedef std::ptrdiff_t																		difference_type;
+			typedef size_t																				size_type;
+
+		private:
+
+			key_compare _kcomparer;
+			container_type _values;
+
+		public:
+
+			/************************************* Constructors **************************************/
+
+			explicit flat_set( const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type() )
+			: _kcomparer( comp ), _values( alloc ) {}
+
+			template <class InputIterator>
+			flat_set( InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type() )
+			: _kcomparer( comp ), _values( alloc ) {
+				insert( first, last );
+			}
+
+			flat_set( const flat_set& x ) : _kcomparer( x._kcomparer ), _values( x._values ) {}
+
+			/************************************* Destructor ****************************************/
+
+			~flat_set( void ) {}
+
+			/************************************* Operator = ****************************************/
+
+			flat_set& operator=( const flat_set& x ) {
+				_kcomparer = x._kcomparer;
+				_values = x._values;
+				return *this;
+			}
+
+			/************************************* Iterators *****************************************/
+
+			const_iterator begin( void ) const {
+				return const_iterator( &_values, 0 );
+			}
+
+			const_iterator end( void ) const {
+				return const_iterator( &_values, size() );
+			}
+
+			const_reverse_iterator rbegin( void ) const {
+				return const_reverse_iterator( &_values, static_cast< long >( size() ) - 1 );
+			}
+
+			const_reverse_iterator rend( void ) const {
+				return const_reverse_iterator( &_values, -1 );
+			}
+
+			/************************************* Capacity ******************************************/
+
+			bool empty( void ) const {
+				return _values.empty();
+			}
+
+			size_type size( void ) const {
+				return _values.size();
+			}
+
+			size_type max_size( void ) const {
+				return _values.max_size();
+			}
+
+			void reserve( size_type n ) {
+				_values.reserve( n );
+			}
+
+			/************************************* Modifiers *****************************************/
+
+			pair<iterator, bool> insert( const value_type& val ) {
+				size_type i = lower_index( val );
+				if ( i < size() && !_kcomparer( val, _values[i] ) )
+					return ft::make_pair( to_iterator( i ), false );
+				insert_at( i, val );
+				return ft::make_pair( to_iterator( i ), true );
+			}
+
+			// no search when val goes right before position
+			iterator insert( iterator position, const value_type& val ) {
+				size_type i = position - begin();
+				if ( ( i == 0 || _kcomparer( _values[i - 1], val ) ) && ( i == size() || _kcomparer( val, _values[i] ) ) ) {
+					insert_at( i, val );
+					return to_iterator( i );
+				}
+				return insert( val ).first;
+			}
+
+			// appends the range, then sorts and merges the new values in
+			template <class InputIterator>
+			void insert( InputIterator first, InputIterator last ) {
+				size_type old = size();
+				for ( ; first != last; first++ )
+					_values.push_back( *first );
+				merge_tail( old );
+			}
+
+			// returns the iterator to the next element, the others are invalidated
+			iterator erase( iterator position ) {
+				size_type i = position - begin();
+				if ( i == size() )
+					return position;
+				erase_at( i, i + 1 );
+				return to_iterator( i );
+			}
+
+			size_type erase( const value_type& val ) {
+				size_type i = find_index( val );
+				if ( i == size() )
+					return 0;
+				erase_at( i, i + 1 );
+				return 1;
+			}
+
+			void erase( iterator first, iterator last ) {
+				erase_at( first - begin(), last - begin() );
+			}
+
+			void swap( flat_set& x ) {
+				key_compare comp = _kcomparer;
+				_kcomparer = x._kcomparer;
+				x._kcomparer = comp;
+				_values.swap( x._values );
+			}
+
+			void clear( void ) {
+				_values.clear();
+			}
+
+			/************************************* Observers *****************************************/
+
+			key_compare key_comp( void ) const {
+				return _kcomparer;
+			}
+
+			value_compare value_comp( void ) const {
+				return _kcomparer;
+			}
+
+			// the sorted values
+			const container_type& values( void ) const {
+				return _values;
+			}
+
+			/************************************* Operations ****************************************/
+
+			const_iterator find( const value_type& val ) const {
+				return to_iterator( find_index( val ) );
+			}
+
+			size_type count( const value_type& val ) const {
+				return find_index( val ) != size() ? 1 : 0;
+			}
+
+			const_iterator lower_bound( const value_type& val ) const {
+				return to_iterator( lower_index( val ) );
+			}
+
+			const_iterator upper_bound( const value_type& val ) const {
+				return to_iterator( upper_index( val ) );
+			}
+
+			pair<const_iterator,const_iterator> equal_range( const value_type& val ) const {
+				return ft::make_pair( lower_bound( val ), upper_bound( val ) );
+			}
+
+			// lookups by another key type, with a transparent comparator as for ft::set
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type find( const K& k ) const {
+				return to_iterator( find_index( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, size_type >::type count( const K& k ) const {
+				return find_index( k ) != size() ? 1 : 0;
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type lower_bound( const K& k ) const {
+				return to_iterator( lower_index( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type upper_bound( const K& k ) const {
+				return to_iterator( upper_index( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, pair<const_iterator,const_iterator> >::type equal_range( const K& k ) const {
+				return ft::make_pair( to_iterator( lower_index( k ) ), to_iterator( upper_index( k ) ) );
+			}
+
+			/************************************* Allocator *****************************************/
+
+			allocator_type get_allocator( void ) const {
+				return _values.get_allocator();
+			}
+
+		private:
+
+			// orders two positions of the value vector
+			class index_comp {
+
+				public:
+
+					index_comp( const container_type& values, const key_compare& comp ) : _values( values ), _comp( comp ) {}
+
+					bool operator()( size_type a, size_type b ) const {
+						return _comp( _values[a], _values[b] );
+					}
+
+				private:
+
+					const container_type& _values;
+					key_compare _comp;
+
+			};
+
+			template <class K>
+			size_type lower_index( const K& k ) const {
+				size_type first = 0;
+				size_type len = size();
+				while ( len > 0 ) {
+					size_type half = len / 2;
+					if ( _kcomparer( _values[first + half], k ) ) {
+						first += half + 1;
+						len -= half + 1;
+					}
+					else
+						len = half;
+				}
+				return first;
+			}
+
+			template <class K>
+			size_type upper_index( const K& k ) const {
+				size_type first = 0;
+				size_type len = size();
+				while ( len > 0 ) {
+					size_type half = len / 2;
+					if ( !_kcomparer( k, _values[first + half] ) ) {
+						first += half + 1;
+						len -= half + 1;
+					}
+					else
+						len = half;
+				}
+				return first;
+			}
+
+			template <class K>
+			size_type find_index( const K& k ) const {
+				size_type i = lower_index( k );
+				if ( i < size() && !_kcomparer( k, _values[i] ) )
+					return i;
+				return size();
+			}
+
+			const_iterator to_iterator( size_type i ) const {
+				return const_iterator( &_values, i );
+			}
+
+			void insert_at( size_type i, value_type val ) {
+				_values.push_back( val );
+				for ( size_type j = size() - 1; j > i; j-- )
+					_values[j] = _values[j - 1];
+				_values[i] = val;
+			}
+
+			void erase_at( size_type first, size_type last ) {
+				size_type n = last - first;
+				for ( size_type i = last; i < size(); i++ )
+					_values[i - n] = _values[i];
+				for ( size_type i = 0; i < n; i++ )
+					_values.pop_back();
+			}
+
+			// same as flat_map: stable sort of the new values, then one merge pass
+			void merge_tail( size_type old ) {
+				size_type n = size() - old;
+				size_type i = ( old > 0 ) ? old : 1;
+				while ( i < size() && _kcomparer( _values[i - 1], _values[i] ) )
+					i++;
+				if ( i >= size() )
+					return ;
+				ft::vector< size_type > order( n );
+				ft::vector< size_type > buffer( n );
+				for ( size_type j = 0; j < n; j++ )
+					order[j] = old + j;
+				ft::merge_sort( &order[0], &order[0] + n, &buffer[0], index_comp( _values, _kcomparer ) );
+				container_type values( _values.get_allocator() );
+				values.reserve( size() );
+				size_type j = 0;
+				i = 0;
+				while ( i < old || j < n ) {
+					if ( j == n || ( i < old && _kcomparer( _values[i], _values[order[j]] ) ) ) {
+						values.push_back( _values[i++] );
+						continue ;
+					}
+					size_type k = order[j++];
+					if ( i < old && !_kcomparer( _values[k], _values[i] ) )
+						continue ;
+					if ( !values.empty() && !_kcomparer( values.back(), _values[k] ) )
+						continue ;
+					values.push_back( _values[k] );
+				}
+				_values.swap( values );
+			}
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef HASH_HPP
+#define HASH_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace ft {
+
+	/*
+	** Hash functors for the unordered containers. Integers hash to
+	** themselves as in most standard libraries: the tables mix every hash
+	** with hash_mix before using its bits, so a weak hash is fine.
+	*/
+	template <class T>
+	struct hash;
+
+	template <class T>
+	struct hash<T*> {
+		size_t operator()( T* p ) const {
+			return reinterpret_cast< size_t >( p );
+		}
+	};
+
+#define FT_INTEGRAL_HASH( T )							\
+	template <>											\
+	struct hash<T> {									\
+		size_t operator()( T x ) const {				\
+			return static_cast< size_t >( x );			\
+		}												\
+	};
+
+	FT_INTEGRAL_HASH( bool )
+	FT_INTEGRAL_HASH( char )
+	FT_INTEGRAL_HASH( signed char )
+	FT_INTEGRAL_HASH( unsigned char )
+	FT_INTEGRAL_HASH( wchar_t )
+	FT_INTEGRAL_HASH( short )
+	FT_INTEGRAL_HASH( unsigned short )
+	FT_INTEGRAL_HASH( int )
+	FT_INTEGRAL_HASH( unsigned int )
+	FT_INTEGRAL_HASH( long )
+	FT_INTEGRAL_HASH( unsigned long )
+
+#undef FT_INTEGRAL_HASH
+
+	// FNV-1a over the characters
+	template <>
+	struct hash<std::string> {
+		size_t operator()( const std::string& s ) const {
+			size_t h = 2166136261UL;
+			for ( size_t i = 0; i < s.size(); i++ ) {
+				h ^= static_cast< unsigned char >( s[i] );
+				h *= 16777619UL;
+			}
+			return h;
+		}
+	};
+
+	// spreads every bit of h over the low bits, which pick the slot and the control byte
+	inline size_t hash_mix( size_t h ) {
+		h ^= h >> ( sizeof( size_t ) * 4 );
+		h *= 0x85ebca6bUL;
+		h ^= h >> 13;
+		h *= 0xc2b2ae35UL;
+		h ^= h >> 16;
+		return h;
+	}
+
+}
+
+#endif
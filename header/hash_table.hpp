@@ -0,0 +1,665 @@
+#ifndef HASH_TABLE_HPP
+#define HASH_TABLE_HPP
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include "vector.hpp"
+#include "iterator.hpp"
+#include "hash.hpp"
+
+#ifdef __SSE2__
+	#include <emmintrin.h>
+#endif
+
+namespace ft {
+
+	/*
+	** Control bytes of the open addressing table, one per slot: a full slot
+	** holds the 7 low bits of the hash of its value, anything negative is a
+	** free or special slot.
+	*/
+	typedef signed char	hash_ctrl;
+
+	static const hash_ctrl	ctrl_empty = -128;
+	static const hash_ctrl	ctrl_deleted = -2;
+	static const hash_ctrl	ctrl_sentinel = -1;		// ends the iteration
+
+	inline unsigned hash_lowest_bit( unsigned mask ) {
+#ifdef __GNUC__
+		return __builtin_ctz( mask );
+#else
+		unsigned i = 0;
+		while ( !( mask & 1 ) ) {
+			mask >>= 1;
+			i++;
+		}
+		return i;
+#endif
+	}
+
+	inline unsigned hash_highest_bit( unsigned mask ) {
+#ifdef __GNUC__
+		return sizeof( unsigned ) * 8 - 1 - __builtin_clz( mask );
+#else
+		unsigned i = 0;
+		while ( mask >>= 1 )
+			i++;
+		return i;
+#endif
+	}
+
+	/*
+	** 16 consecutive control bytes, compared all at once: each match
+	** returns a mask with bit i set when byte i matches. SSE2 does it in a
+	** couple of instructions, other targets fall back to a loop.
+	*/
+	class hash_group {
+
+		public:
+
+			static const size_t width = 16;
+
+#ifdef __SSE2__
+			explicit hash_group( const hash_ctrl* pos ) : _ctrl( _mm_loadu_si128( reinterpret_cast< const __m128i* >( pos ) ) ) {}
+
+			unsigned match( hash_ctrl h2 ) const {
+				return _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_set1_epi8( h2 ), _ctrl ) );
+			}
+
+			unsigned match_empty( void ) const {
+				return _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_set1_epi8( ctrl_empty ), _ctrl ) );
+			}
+
+			unsigned match_empty_or_deleted( void ) const {
+				return _mm_movemask_epi8( _mm_cmpgt_epi8( _mm_set1_epi8( ctrl_sentinel ), _ctrl ) );
+			}
+
+		private:
+
+			__m128i	_ctrl;
+#else
+			explicit hash_group( const hash_ctrl* pos ) : _ctrl( pos ) {}
+
+			unsigned match( hash_ctrl h2 ) const {
+				unsigned mask = 0;
+				for ( size_t i = 0; i < width; i++ )
+					mask |= static_cast< unsigned >( _ctrl[i] == h2 ) << i;
+				return mask;
+			}
+
+			unsigned match_empty( void ) const {
+				return match( ctrl_empty );
+			}
+
+			unsigned match_empty_or_deleted( void ) const {
+				unsigned mask = 0;
+				for ( size_t i = 0; i < width; i++ )
+					mask |= static_cast< unsigned >( _ctrl[i] < ctrl_sentinel ) << i;
+				return mask;
+			}
+
+		private:
+
+			const hash_ctrl*	_ctrl;
+#endif
+
+	};
+
+	// key of the values of a set, and of a map
+	struct hash_identity {
+		template <class T>
+		const T& operator()( const T& x ) const {
+			return x;
+		}
+	};
+
+	struct hash_select_first {
+		template <class P>
+		const typename P::first_type& operator()( const P& p ) const {
+			return p.first;
+		}
+	};
+
+	template < class T, class Container >
+	class hash_iterator {
+
+		public:
+
+			typedef ft::forward_iterator_tag						iterator_category;
+			typedef std::ptrdiff_t									difference_type;
+			typedef T												value_type;
+			typedef T*												pointer;
+			typedef T&												reference;
+			typedef Container const									container_type;
+			typedef container_type*									container_pointer;
+
+			/************************* Constructors and Destructor ***************************/
+
+			hash_iterator( void ) : _ctrl( NULL ), _slot( NULL ) {}
+			hash_iterator( const hash_ctrl* ctrl, T* slot ) : _ctrl( ctrl ), _slot( slot ) {}
+			hash_iterator( hash_iterator const & cpy ) {
+				*this = cpy;
+			}
+			~hash_iterator( void ) {}
+
+			/************************* Member Functions **************************************/
+
+			const hash_ctrl* getCtrl( void ) const {
+				return _ctrl;
+			}
+
+			T* getSlot( void ) const {
+				return _slot;
+			}
+
+			/************************* Implement operators ***********************************/
+
+			hash_iterator& operator=( hash_iterator const & rhs ) {
+				_ctrl = rhs._ctrl;
+				_slot = rhs._slot;
+				return *this;
+			}
+
+			reference operator*( void ) const {
+				return *_slot;
+			}
+
+			pointer operator->( void ) const {
+				return _slot;
+			}
+
+			hash_iterator& operator++( void ) {
+				++_ctrl;
+				++_slot;
+				while ( *_ctrl < ctrl_sentinel ) {
+					++_ctrl;
+					++_slot;
+				}
+				return *this;
+			}
+
+			hash_iterator operator++( int ) {
+				hash_iterator tmp = *this;
+				++( *this );
+				return tmp;
+			}
+
+		private:
+
+			const hash_ctrl*	_ctrl;
+			T*					_slot;
+
+	};
+
+	template < class T, class Container >
+	class const_hash_iterator {
+
+		public:
+
+			typedef ft::forward_iterator_tag						iterator_category;
+			typedef std::ptrdiff_t									difference_type;
+			typedef T												value_type;
+			typedef T*												pointer;
+			typedef T&												reference;
+			typedef T const *										const_pointer;
+			typedef T const &										const_reference;
+			typedef Container const									container_type;
+			typedef container_type *								container_pointer;
+
+			/************************* Constructors and Destructor ***************************/
+
+			const_hash_iterator( void ) : _ctrl( NULL ), _slot( NULL ) {}
+			const_hash_iterator( const hash_ctrl* ctrl, T* slot ) : _ctrl( ctrl ), _slot( slot ) {}
+			const_hash_iterator( hash_iterator<T, Container> const & it ) : _ctrl( it.getCtrl() ), _slot( it.getSlot() ) {}
+			const_hash_iterator( const_hash_iterator const & copy ) {
+				*this = copy;
+			}
+			~const_hash_iterator( void ) {}
+
+			/************************* Member Functions **************************************/
+
+			const hash_ctrl* getCtrl( void ) const {
+				return _ctrl;
+			}
+
+			T* getSlot( void ) const {
+				return _slot;
+			}
+
+			/************************* Implement operators ***********************************/
+
+			const_hash_iterator& operator=( const_hash_iterator const & rhs ) {
+				_ctrl = rhs._ctrl;
+				_slot = rhs._slot;
+				return *this;
+			}
+
+			const_reference operator*( void ) const {
+				return *_slot;
+			}
+
+			const_pointer operator->( void ) const {
+				return _slot;
+			}
+
+			const_hash_iterator& operator++( void ) {
+				++_ctrl;
+				++_slot;
+				while ( *_ctrl < ctrl_sentinel ) {
+					++_ctrl;
+					++_slot;
+				}
+				return *this;
+			}
+
+			const_hash_iterator operator++( int ) {
+				const_hash_iterator tmp = *this;
+				++( *this );
+				return tmp;
+			}
+
+		private:
+
+			const hash_ctrl*	_ctrl;
+			T*					_slot;
+
+	};
+
+	template <class T, class Container>
+	bool operator==( hash_iterator<T, Container> const & lhs, hash_iterator<T, Container> const & rhs ) {
+		return lhs.getCtrl() == rhs.getCtrl();
+	}
+	template <class T, class Container>
+	bool operator!=( hash_iterator<T, Container> const & lhs, hash_iterator<T, Container> const & rhs ) {
+		return lhs.getCtrl() != rhs.getCtrl();
+	}
+
+	template <class T, class Container>
+	bool operator==( const_hash_iterator<T, Container> const & lhs, const_hash_iterator<T, Container> const & rhs ) {
+		return lhs.getCtrl() == rhs.getCtrl();
+	}
+	template <class T, class Container>
+	bool operator!=( const_hash_iterator<T, Container> const & lhs, const_hash_iterator<T, Container> const & rhs ) {
+		return lhs.getCtrl() != rhs.getCtrl();
+	}
+
+	/*
+	** Open addressing table in the SwissTable layout: values live directly
+	** in one array of slots, a parallel array of control bytes tells which
+	** slots are full and keeps 7 bits of their hash. A lookup probes whole
+	** groups of 16 control bytes and only compares keys whose 7 bits match,
+	** so a miss rarely touches a value at all.
+	**
+	** The capacity is 2^n - 1 and the control array has capacity + 1 +
+	** width - 1 bytes: a sentinel, then a copy of the first bytes so a group
+	** can be loaded from any slot without wrapping. At most 7/8 of the
+	** slots are used. Inserts may move every value, erases only leave a
+	** tombstone and never invalidate the other iterators.
+	*/
+	template < class T, class Key, class GetKey, class Hash, class Pred, class Alloc = std::allocator< T > >
+	class hash_table {
+
+		private:
+
+			typedef typename Alloc::template rebind< hash_ctrl >::other				ctrl_alloc;
+
+			static const size_t width = hash_group::width;
+			static const size_t min_capacity = width - 1;
+
+			hash_ctrl* _ctrl;
+			T* _slots;
+			size_t _capacity;
+			size_t _size;
+			size_t _growth_left;		// inserts before a rehash
+			Alloc _allocator;
+			ctrl_alloc _ctrls;
+			Hash _hasher;
+			Pred _equal;
+
+		public:
+
+			typedef hash_iterator< T, hash_table >									iterator;
+			typedef const_hash_iterator< T, hash_table >							const_iterator;
+
+			hash_table( const Hash& hasher, const Pred& equal, const Alloc& alloc )
+			: _ctrl( empty_group() ), _slots( NULL ), _capacity( 0 ), _size( 0 ), _growth_left( 0 ),
+			_allocator( alloc ), _ctrls( alloc ), _hasher( hasher ), _equal( equal ) {}
+
+			// same capacity and layout as x: the values are copied slot to slot
+			hash_table( const hash_table& x )
+			: _ctrl( empty_group() ), _slots( NULL ), _capacity( 0 ), _size( 0 ), _growth_left( 0 ),
+			_allocator( x._allocator ), _ctrls( x._ctrls ), _hasher( x._hasher ), _equal( x._equal ) {
+				copy( x );
+			}
+
+			~hash_table( void ) {
+				destroy();
+			}
+
+			hash_table& operator=( const hash_table& x ) {
+				if ( this == &x )
+					return *this;
+				destroy();
+				_ctrl = empty_group();
+				_slots = NULL;
+				_capacity = 0;
+				_size = 0;
+				_growth_left = 0;
+				_allocator = x._allocator;
+				_ctrls = x._ctrls;
+				_hasher = x._hasher;
+				_equal = x._equal;
+				copy( x );
+				return *this;
+			}
+
+			iterator begin( void ) {
+				iterator it( _ctrl, _slots );
+				if ( *_ctrl < ctrl_sentinel )
+					++it;
+				return it;
+			}
+
+			const_iterator begin( void ) const {
+				return const_cast< hash_table* >( this )->begin();
+			}
+
+			iterator end( void ) {
+				return iterator( _ctrl + _capacity, _slots + _capacity );
+			}
+
+			const_iterator end( void ) const {
+				return const_iterator( _ctrl + _capacity, _slots + _capacity );
+			}
+
+			size_t getSize( void ) const {
+				return _size;
+			}
+
+			size_t getCapacity( void ) const {
+				return _capacity;
+			}
+
+			Alloc getAllocator( void ) const {
+				return _allocator;
+			}
+
+			Hash getHasher( void ) const {
+				return _hasher;
+			}
+
+			Pred getEqual( void ) const {
+				return _equal;
+			}
+
+			/*
+			** Returns true and the slot of the value whose key equals key, or
+			** false and the first free slot of its probe sequence, where
+			** add_at will put it. hash is set for add_at either way.
+			*/
+			template <class K>
+			bool find_slot( K const & key, size_t* hash, size_t* index ) const {
+				size_t h = hash_mix( _hasher( key ) );
+				hash_ctrl h2 = static_cast< hash_ctrl >( h & 0x7F );
+				size_t offset = ( h >> 7 ) & _capacity;
+				size_t step = 0;
+				size_t free_index = 0;
+				bool found_free = false;
+				*hash = h;
+				while ( true ) {
+					hash_group group( _ctrl + offset );
+					for ( unsigned mask = group.match( h2 ); mask; mask &= mask - 1 ) {
+						size_t i = ( offset + hash_lowest_bit( mask ) ) & _capacity;
+						if ( _equal( GetKey()( _slots[i] ), key ) ) {
+							*index = i;
+							return true;
+						}
+					}
+					if ( !found_free ) {
+						unsigned mask = group.match_empty_or_deleted();
+						if ( mask ) {
+							free_index = ( offset + hash_lowest_bit( mask ) ) & _capacity;
+							found_free = true;
+						}
+					}
+					if ( group.match_empty() ) {
+						*index = free_index;
+						return false;
+					}
+					step += width;
+					offset = ( offset + step ) & _capacity;
+				}
+			}
+
+			// index and hash come from a find_slot that returned false
+			iterator add_at( size_t index, size_t hash, T const & value ) {
+				if ( _growth_left == 0 && _ctrl[index] != ctrl_deleted ) {
+					grow();
+					index = find_free( hash );
+				}
+				_allocator.construct( _slots + index, value );
+				if ( _ctrl[index] == ctrl_empty )
+					_growth_left--;
+				set_ctrl( index, static_cast< hash_ctrl >( hash & 0x7F ) );
+				_size++;
+				return iterator( _ctrl + index, _slots + index );
+			}
+
+			// nothing is built when value is already there
+			iterator add( T const & value, bool* duplicate ) {
+				size_t hash;
+				size_t index;
+				*duplicate = find_slot( GetKey()( value ), &hash, &index );
+				if ( *duplicate )
+					return to_iterator( index );
+				return add_at( index, hash, value );
+			}
+
+			template <class K>
+			iterator search( K const & key ) const {
+				size_t hash;
+				size_t index;
+				if ( find_slot( key, &hash, &index ) )
+					return to_iterator( index );
+				return const_cast< hash_table* >( this )->end();
+			}
+
+			iterator to_iterator( size_t index ) const {
+				return iterator( _ctrl + index, _slots + index );
+			}
+
+			/*
+			** The slot becomes empty again if no group around it was ever
+			** full, as no probe went past it then. Otherwise it is left as a
+			** tombstone that lookups step over and inserts may reuse.
+			*/
+			void del( iterator it ) {
+				size_t index = it.getSlot() - _slots;
+				size_t before = ( index - width ) & _capacity;
+				unsigned empty_after = hash_group( _ctrl + index ).match_empty();
+				unsigned empty_before = hash_group( _ctrl + before ).match_empty();
+				bool never_full = empty_before && empty_after
+					&& hash_lowest_bit( empty_after ) + ( width - 1 - hash_highest_bit( empty_before ) ) < width;
+				_allocator.destroy( _slots + index );
+				set_ctrl( index, never_full ? ctrl_empty : ctrl_deleted );
+				if ( never_full )
+					_growth_left++;
+				_size--;
+			}
+
+			void del_range( iterator first, iterator last ) {
+				if ( first == begin() && last == end() )
+					return clear();
+				while ( first != last )
+					del( first++ );
+			}
+
+			// keeps the capacity
+			void clear( void ) {
+				if ( _capacity == 0 )
+					return ;
+				for ( size_t i = 0; i < _capacity; i++ )
+					if ( _ctrl[i] >= 0 )
+						_allocator.destroy( _slots + i );
+				reset_ctrl();
+				_size = 0;
+				_growth_left = max_load( _capacity );
+			}
+
+			// room for n values without rehashing
+			void reserve( size_t n ) {
+				if ( n <= _size + _growth_left )
+					return ;
+				size_t capacity = min_capacity;
+				while ( max_load( capacity ) < n )
+					capacity = capacity * 2 + 1;
+				resize( capacity );
+			}
+
+			// at least n slots, never fewer than the values need
+			void rehash( size_t n ) {
+				size_t capacity = min_capacity;
+				while ( capacity < n || max_load( capacity ) < _size )
+					capacity = capacity * 2 + 1;
+				if ( n == 0 && _size == 0 ) {
+					destroy();
+					_ctrl = empty_group();
+					_slots = NULL;
+					_capacity = 0;
+					_growth_left = 0;
+				}
+				else if ( capacity != _capacity )
+					resize( capacity );
+			}
+
+			void swap( hash_table & x ) {
+				hash_ctrl* c = _ctrl;
+				T* s = _slots;
+				size_t cap = _capacity;
+				size_t size = _size;
+				size_t g = _growth_left;
+				Alloc a = _allocator;
+				ctrl_alloc ca = _ctrls;
+				Hash h = _hasher;
+				Pred e = _equal;
+				_ctrl = x._ctrl;
+				_slots = x._slots;
+				_capacity = x._capacity;
+				_size = x._size;
+				_growth_left = x._growth_left;
+				_allocator = x._allocator;
+				_ctrls = x._ctrls;
+				_hasher = x._hasher;
+				_equal = x._equal;
+				x._ctrl = c;
+				x._slots = s;
+				x._capacity = cap;
+				x._size = size;
+				x._growth_left = g;
+				x._allocator = a;
+				x._ctrls = ca;
+				x._hasher = h;
+				x._equal = e;
+			}
+
+		private:
+
+			// control bytes of a table without slots: every probe stops at once
+			static hash_ctrl* empty_group( void ) {
+				static hash_ctrl group[width] = { ctrl_sentinel, ctrl_empty, ctrl_empty, ctrl_empty,
+					ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+					ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty };
+				return group;
+			}
+
+			static size_t max_load( size_t capacity ) {
+				return capacity - capacity / 8;
+			}
+
+			// sets the control byte of a slot and its copy after the sentinel
+			void set_ctrl( size_t index, hash_ctrl h ) {
+				_ctrl[index] = h;
+				_ctrl[( ( index - ( width - 1 ) ) & _capacity ) + ( width - 1 )] = h;
+			}
+
+			void reset_ctrl( void ) {
+				std::memset( _ctrl, ctrl_empty, _capacity + width );
+				_ctrl[_capacity] = ctrl_sentinel;
+			}
+
+			// first empty or deleted slot of the probe sequence of hash
+			size_t find_free( size_t hash ) const {
+				size_t offset = ( hash >> 7 ) & _capacity;
+				size_t step = 0;
+				while ( true ) {
+					unsigned mask = hash_group( _ctrl + offset ).match_empty_or_deleted();
+					if ( mask )
+						return ( offset + hash_lowest_bit( mask ) ) & _capacity;
+					step += width;
+					offset = ( offset + step ) & _capacity;
+				}
+			}
+
+			// the table is full of values and tombstones: drop the tombstones if they are many, else double
+			void grow( void ) {
+				if ( _capacity > min_capacity && _size * 32 <= _capacity * 25 )
+					resize( _capacity );
+				else
+					resize( _capacity ? _capacity * 2 + 1 : min_capacity );
+			}
+
+			// moves every value into new arrays of capacity slots
+			void resize( size_t capacity ) {
+				hash_ctrl* old_ctrl = _ctrl;
+				T* old_slots = _slots;
+				size_t old_capacity = _capacity;
+				_capacity = capacity;
+				_ctrl = _ctrls.allocate( capacity + width );
+				_slots = _allocator.allocate( capacity );
+				reset_ctrl();
+				for ( size_t i = 0; i < old_capacity; i++ ) {
+					if ( old_ctrl[i] < 0 )
+						continue ;
+					size_t hash = hash_mix( _hasher( GetKey()( old_slots[i] ) ) );
+					size_t index = find_free( hash );
+					_allocator.construct( _slots + index, old_slots[i] );
+					_allocator.destroy( old_slots + i );
+					set_ctrl( index, static_cast< hash_ctrl >( hash & 0x7F ) );
+				}
+				_growth_left = max_load( _capacity ) - _size;
+				if ( old_capacity ) {
+					_ctrls.deallocate( old_ctrl, old_capacity + width );
+					_allocator.deallocate( old_slots, old_capacity );
+				}
+			}
+
+			void copy( const hash_table& x ) {
+				if ( x._capacity == 0 )
+					return ;
+				_capacity = x._capacity;
+				_ctrl = _ctrls.allocate( _capacity + width );
+				_slots = _allocator.allocate( _capacity );
+				std::memcpy( _ctrl, x._ctrl, _capacity + width );
+				for ( size_t i = 0; i < _capacity; i++ )
+					if ( _ctrl[i] >= 0 )
+						_allocator.construct( _slots + i, x._slots[i] );
+				_size = x._size;
+				_growth_left = x._growth_left;
+			}
+
+			void destroy( void ) {
+				if ( _capacity == 0 )
+					return ;
+				for ( size_t i = 0; i < _capacity; i++ )
+					if ( _ctrl[i] >= 0 )
+						_allocator.destroy( _slots + i );
+				_ctrls.deallocate( _ctrl, _capacity + width );
+				_allocator.deallocate( _slots, _capacity );
+			}
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,491 @@
+#ifndef INTERVAL_MAP_HPP
+#define INTERVAL_MAP_HPP
+
+#include "tree.hpp"
+
+namespace ft {
+
+	/*
+	** Node of an interval_map: the value's key is a half-open interval
+	** [first, second) and max_end the greatest end in the subtree, so a
+	** query can skip every subtree that ends before it starts. The ends are
+	** ordered by the map's own comparator, handed over by the tree.
+	*/
+	template <class T, class Bound>
+	struct interval_tree_node : tree_node<T> {
+
+		static const bool	augmented = true;
+		static const bool	ranked = false;
+
+		Bound		max_end;
+
+		interval_tree_node( const T& val ) : tree_node<T>( val ), max_end( val.first.second ) {}
+
+		template <class Comp>
+		void update( const Comp& comp ) {
+			max_end = this->value.first.second;
+			if ( this->left && comp.bound_less( max_end, end_of( this->left ) ) )
+				max_end = end_of( this->left );
+			if ( this->right && comp.bound_less( max_end, end_of( this->right ) ) )
+				max_end = end_of( this->right );
+		}
+
+		static const Bound& end_of( const tree_node_base* node ) {
+			return static_cast< const interval_tree_node* >( node )->max_end;
+		}
+
+	};
+
+	/*
+	** Walks the intervals of a tree that meet a query, in key order, with
+	** nothing but the current node: an in-order walk through parent links
+	** that skips the subtrees whose max_end is not after the query start and
+	** stops at the first interval that starts past the query.
+	*/
+	template <class T, class Node, class Bound, class Compare>
+	class interval_query_iterator {
+
+		public:
+
+			typedef ft::forward_iterator_tag						iterator_category;
+			typedef std::ptrdiff_t									difference_type;
+			typedef T												value_type;
+			typedef T*												pointer;
+			typedef T&												reference;
+
+			/************************* Constructors and Destructor ***************************/
+
+			interval_query_iterator( void ) : _node( NULL ), _header( NULL ), _point( false ) {}
+
+			// the end of any query on the tree of header
+			explicit interval_query_iterator( const tree_node_base* header )
+			: _node( const_cast< tree_node_base* >( header ) ), _header( header ), _point( false ) {}
+
+			// intervals meeting [lo, hi), or holding lo when point is set
+			interval_query_iterator( const tree_node_base* header, const Bound& lo, const Bound& hi, bool point, const Compare& comp )
+			: _node( NULL ), _header( header ), _lo( lo ), _hi( hi ), _point( point ), _comp( comp ) {
+				tree_node_base* root = header->getParent();
+				settle( viable( root ) ? leftmost( root ) : const_cast< tree_node_base* >( header ) );
+			}
+
+			~interval_query_iterator( void ) {}
+
+			/************************* Member Functions **************************************/
+
+			tree_node_base * getNode( void ) const {
+				return _node;
+			}
+
+			/************************* Implement operators ***********************************/
+
+			reference operator*( void ) const {
+				return static_cast< Node* >( _node )->value;
+			}
+
+			pointer operator->( void ) const {
+				return &static_cast< Node* >( _node )->value;
+			}
+
+			interval_query_iterator& operator++( void ) {
+				settle( next( _node ) );
+				return *this;
+			}
+
+			interval_query_iterator operator++( int ) {
+				interval_query_iterator tmp( *this );
+				++( *this );
+				return tmp;
+			}
+
+			bool operator==( const interval_query_iterator& rhs ) const {
+				return _node == rhs._node;
+			}
+
+			bool operator!=( const interval_query_iterator& rhs ) const {
+				return _node != rhs._node;
+			}
+
+		private:
+
+			tree_node_base*			_node;
+			const tree_node_base*	_header;
+			Bound					_lo;
+			Bound					_hi;
+			bool					_point;
+			Compare					_comp;
+
+			static const T& value( const tree_node_base* node ) {
+				return static_cast< const Node* >( node )->value;
+			}
+
+			// some interval of the subtree ends after the query start
+			bool viable( const tree_node_base* node ) const {
+				return node && _comp( _lo, Node::end_of( node ) );
+			}
+
+			// node and everything before it start before the query end
+			bool started( const tree_node_base* node ) const {
+				if ( _point )
+					return !_comp( _lo, value( node ).first.first );
+				return _comp( value( node ).first.first, _hi );
+			}
+
+			tree_node_base* leftmost( tree_node_base* node ) const {
+				while ( viable( node->left ) )
+					node = node->left;
+				return node;
+			}
+
+			// in-order successor among the viable subtrees, the header at the end
+			tree_node_base* next( tree_node_base* node ) const {
+				if ( viable( node->right ) )
+					return leftmost( node->right );
+				while ( node->getParent() != _header && !node->isLeft() )
+					node = node->getParent();
+				return node->getParent();
+			}
+
+			// moves to the first match from node on
+			void settle( tree_node_base* node ) {
+				while ( node != _header && started( node ) && !_comp( _lo, value( node ).first.second ) )
+					node = next( node );
+				if ( node != _header && !started( node ) )
+					node = const_cast< tree_node_base* >( _header );
+				_node = node;
+			}
+
+	};
+
+	/*
+	** Map from half-open intervals [first, second) to values, ordered by
+	** start then end. Every node keeps the greatest end below it, which
+	** lets overlapping() and stabbing() walk only the subtrees that can
+	** hold a match: O(log n + k log(n / k)) for k results, without
+	** allocating. Intervals are expected to be non-empty.
+	*/
+	template < class Bound, class T, class Compare = std::less<Bound>, class Alloc = std::allocator< pair< const pair< Bound, Bound >, T > > >
+	class interval_map {
+
+		private:
+
+			class value_comp;
+
+		public:
+
+			/************************************* Typedefs ******************************************/
+
+			typedef Bound																				bound_type;
+			typedef pair< bound_type, bound_type >														key_type;
+			typedef T																					mapped_type;
+			typedef Compare																				bound_compare;
+			typedef value_comp																			value_compare;
+			typedef pair< key_type, mapped_type >														value_type;
+			typedef Alloc																				allocator_type;
+			typedef interval_tree_node< value_type, bound_type >										tree_node_type;
+			typedef typename allocator_type::template rebind< tree_node_type >::other					new_alloc;
+			typedef typename allocator_type::reference													reference;
+			typedef typename allocator_type::const_reference											const_reference;
+			typedef typename allocator_type::pointer													pointer;
+			typedef typename allocator_type::const_pointer												const_pointer;
+			typedef ft::tree< value_type, value_compare, new_alloc, tree_node_type >					tree_type;
+			typedef tree_iterator< value_type, tree_type >												iterator;
+			typedef const_tree_iterator< value_type, tree_type >										const_iterator;
+			typedef reverse_iterator<iterator>															reverse_iterator;
+			typedef const_reverse_iterator<const_iterator>												const_reverse_iterator;
+			typedef interval_query_iterator< value_type, tree_node_type, bound_type, bound_compare >		query_iterator;
+			typedef interval_query_iterator< const value_type, tree_node_type, bound_type, bound_compare >	const_query_iterator;
+			typedef std::ptrdiff_t																		difference_type;
+			typedef size_t																				size_type;
+
+		private:
+
+			bound_compare _bcomparer;
+			value_compare _vcomparer;
+			allocator_type _allocator;
+			tree_type _tree;
+
+		public:
+
+			/************************************* Constructors **************************************/
+
+			explicit interval_map( const bound_compare& comp = bound_compare(), const new_alloc& alloc = new_alloc() )
+			: _bcomparer( comp ), _vcomparer( comp ), _allocator( alloc ), _tree( _vcomparer, alloc ) {}
+
+			template <class InputIterator>
+			interval_map( InputIterator first, InputIterator last, const bound_compare& comp = bound_compare(), const new_alloc& alloc = new_alloc() )
+			: _bcomparer( comp ), _vcomparer( comp ), _allocator( alloc ), _tree( first, last, _vcomparer, alloc ) {}
+
+			interval_map( const interval_map& x ) {
+				*this = x;
+			}
+
+			/************************************* Destructor ****************************************/
+
+			~interval_map( void ) {}
+
+			/************************************* Operator = ****************************************/
+
+			interval_map& operator=( const interval_map& x ) {
+				_tree = x._tree;
+				_vcomparer = x._vcomparer;
+				_bcomparer = x._bcomparer;
+				_allocator = x._allocator;
+				return *this;
+			}
+
+			/************************************* Iterators *****************************************/
+
+			iterator begin( void ) {
+				return _tree.begin();
+			}
+
+			const_iterator begin( void ) const {
+				return _tree.begin();
+			}
+
+			iterator end( void ) {
+				return _tree.end();
+			}
+
+			const_iterator end( void ) const {
+				return _tree.end();
+			}
+
+			reverse_iterator rbegin( void ) {
+				return _tree.rbegin();
+			}
+
+			const_reverse_iterator rbegin( void ) const {
+				return _tree.rbegin();
+			}
+
+			reverse_iterator rend( void ) {
+				return _tree.rend();
+			}
+
+			const_reverse_iterator rend( void ) const {
+				return _tree.rend();
+			}
+
+			/************************************* Capacity ******************************************/
+
+			bool empty( void ) const {
+				return ( _tree.getSize() == 0 ) ? true : false;
+			}
+
+			size_type size( void ) const {
+				return _tree.getSize();
+			}
+
+			size_type max_size( void ) const {
+				return _tree.getAllocator().max_size();
+			}
+
+			/************************************* Element access ************************************/
+
+			mapped_type& operator[]( const key_type& k ) {
+				return insert( value_type( k, mapped_type() ) ).first->second;
+			}
+
+			/************************************* Modifiers *****************************************/
+
+			pair<iterator, bool> insert( const value_type& val ) {
+				bool duplicate = false;
+				tree_node< value_type >* res = _tree.add( val, &duplicate );
+				return ft::make_pair( iterator( res ), !duplicate );
+			}
+
+			// the interval [lo, hi)
+			pair<iterator, bool> insert( const bound_type& lo, const bound_type& hi, const mapped_type& obj ) {
+				return insert( value_type( key_type( lo, hi ), obj ) );
+			}
+
+			template <class InputIterator>
+			void insert( InputIterator first, InputIterator last ) {
+				while ( first != last ) {
+					insert( *first );
+					first++;
+				}
+			}
+
+			void erase( iterator position ) {
+				if ( position == end() )
+					return ;
+				_tree.del( static_cast< tree_node< value_type >* >( position.getNode() ) );
+			}
+
+			size_type erase( const key_type& k ) {
+				tree_node< value_type >* res = find_node( k );
+				if ( res ) {
+					_tree.del( res );
+					return 1;
+				}
+				return 0;
+			}
+
+			void erase( iterator first, iterator last ) {
+				_tree.del_range( first.getNode(), last.getNode() );
+			}
+
+			void swap( interval_map& x ) {
+				_tree.swap( x._tree );
+			}
+
+			void clear( void ) {
+				_tree.clear();
+			}
+
+			/************************************* Observers *****************************************/
+
+			bound_compare bound_comp( void ) const {
+				return _bcomparer;
+			}
+
+			value_compare value_comp( void ) const {
+				return _vcomparer;
+			}
+
+			/************************************* Operations ****************************************/
+
+			iterator find( const key_type& k ) {
+				return to_iterator( find_node( k ) );
+			}
+
+			const_iterator find( const key_type& k ) const {
+				return to_iterator( find_node( k ) );
+			}
+
+			size_type count( const key_type& k ) const {
+				return find_node( k ) ? 1 : 0;
+			}
+
+			iterator lower_bound( const key_type& k ) {
+				return to_iterator( _tree.lower_search( _tree.getRoot(), k, key_value_comp( _bcomparer ) ) );
+			}
+
+			const_iterator lower_bound( const key_type& k ) const {
+				return to_iterator( _tree.lower_search( _tree.getRoot(), k, key_value_comp( _bcomparer ) ) );
+			}
+
+			iterator upper_bound( const key_type& k ) {
+				return to_iterator( _tree.upper_search( _tree.getRoot(), k, key_value_comp( _bcomparer ) ) );
+			}
+
+			const_iterator upper_bound( const key_type& k ) const {
+				return to_iterator( _tree.upper_search( _tree.getRoot(), k, key_value_comp( _bcomparer ) ) );
+			}
+
+			/************************************* Interval queries **********************************/
+
+			// the intervals sharing a point with [lo, hi), in key order
+			pair<query_iterator, query_iterator> overlapping( const bound_type& lo, const bound_type& hi ) {
+				return ft::make_pair( query_iterator( header(), lo, hi, false, _bcomparer ), query_iterator( header() ) );
+			}
+
+			pair<const_query_iterator, const_query_iterator> overlapping( const bound_type& lo, const bound_type& hi ) const {
+				return ft::make_pair( const_query_iterator( header(), lo, hi, false, _bcomparer ), const_query_iterator( header() ) );
+			}
+
+			// the intervals holding point, in key order
+			pair<query_iterator, query_iterator> stabbing( const bound_type& point ) {
+				return ft::make_pair( query_iterator( header(), point, point, true, _bcomparer ), query_iterator( header() ) );
+			}
+
+			pair<const_query_iterator, const_query_iterator> stabbing( const bound_type& point ) const {
+				return ft::make_pair( const_query_iterator( header(), point, point, true, _bcomparer ), const_query_iterator( header() ) );
+			}
+
+			// whether some interval shares a point with [lo, hi), O(log n)
+			bool overlaps( const bound_type& lo, const bound_type& hi ) const {
+				return const_query_iterator( header(), lo, hi, false, _bcomparer ) != const_query_iterator( header() );
+			}
+
+			/************************************* Allocator *****************************************/
+
+			allocator_type get_allocator( void ) const {
+				return _allocator;
+			}
+
+		private:
+
+			// orders a key against the key of a value, start first then end
+			class key_value_comp {
+
+				public:
+
+					key_value_comp( const bound_compare& comp ) : _comp( comp ) {}
+
+					bool operator()( const value_type& x, const key_type& k ) const {
+						return less( x.first, k );
+					}
+
+					bool operator()( const key_type& k, const value_type& x ) const {
+						return less( k, x.first );
+					}
+
+				private:
+
+					bound_compare _comp;
+
+					bool less( const key_type& a, const key_type& b ) const {
+						if ( _comp( a.first, b.first ) )
+							return true;
+						return !_comp( b.first, a.first ) && _comp( a.second, b.second );
+					}
+
+			};
+
+			const tree_node_base* header( void ) const {
+				return end().getNode();
+			}
+
+			tree_node< value_type >* find_node( const key_type& k ) const {
+				return _tree.search( _tree.getRoot(), k, key_value_comp( _bcomparer ) );
+			}
+
+			iterator to_iterator( tree_node< value_type >* node ) {
+				return node ? iterator( node ) : end();
+			}
+
+			const_iterator to_iterator( tree_node< value_type >* node ) const {
+				return node ? const_iterator( node ) : end();
+			}
+
+			class value_comp : std::binary_function< value_type, value_type, bool > {
+
+				friend class interval_map;
+
+			protected:
+
+				bound_compare comp;
+				value_comp( bound_compare c ) : comp( c ) {}
+
+			public:
+				value_comp( void ) {}
+
+				typedef bool 				result_type;
+				typedef value_type			first_argument_type;
+				typedef value_type			second_argument_type;
+				bool operator()( const value_type& x, const value_type& y ) const {
+					if ( comp( x.first.first, y.first.first ) )
+						return true;
+					return !comp( y.first.first, x.first.first ) && comp( x.first.second, y.first.second );
+				}
+
+				// orders two bounds, for the max_end of the nodes
+				bool bound_less( const bound_type& x, const bound_type& y ) const {
+					return comp( x, y );
+				}
+
+				value_comp& operator=( const value_comp& rhs ) {
+					comp = rhs.comp;
+					return *this;
+				}
+
+			};
+
+	};
+
+}
+
+#endif
@@ -10,6 +10,7 @@ namespace ft {
 
 	struct random_access_iterator_tag {};
 	struct bidirectional_iterator_tag {};
+	struct forward_iterator_tag {};
 
 	template <class Iterator>
 	struct iterator_traits {
@@ -64,6 +65,12 @@ namespace ft {
 			}
 			~iterator( void ) {}
 
+			/************************* Member Functions **************************************/
+
+			long getIndex( void ) const {
+				return _idx;
+			}
+
 			/************************* Implement operators ***********************************/
 
 			iterator& operator=( iterator const & rhs ) {
@@ -150,6 +157,12 @@ namespace ft {
 			}
 			~const_iterator( void ) {}
 
+			/************************* Member Functions **************************************/
+
+			long getIndex( void ) const {
+				return _idx;
+			}
+
 			/************************* Implement operators ***********************************/
 
 			const_iterator& operator=( const_iterator const & rhs ) {
@@ -225,45 +238,36 @@ namespace ft {
 
 			/************************* Constructors and Destructor ***************************/
 
-			tree_iterator( void ) {}
-			tree_iterator( container_pointer container, tree_node<value_type> * ptr ) : _container( container ), _ptr( ptr ) {}
+			tree_iterator( void ) : _ptr( NULL ) {}
+			explicit tree_iterator( tree_node_base * ptr ) : _ptr( ptr ) {}
 			tree_iterator( tree_iterator const & cpy ) {
 				*this = cpy;
 			}
 			~tree_iterator( void ) {}
 
+			/************************* Member Functions **************************************/
+
+			tree_node_base * getNode( void ) const {
+				return _ptr;
+			}
+
 			/************************* Implement operators ***********************************/
 
 			tree_iterator& operator=( tree_iterator const & rhs ) {
 				_ptr = rhs._ptr;
-				_container = rhs._container;
 				return *this;
 			}
 
 			reference operator*( void ) const {
-				return _ptr->value;
+				return static_cast< tree_node<T>* >( _ptr )->value;
 			}
 
-			pointer operator->( void ) {
-				return &_ptr->value;
+			pointer operator->( void ) const {
+				return &static_cast< tree_node<T>* >( _ptr )->value;
 			}
 
 			tree_iterator& operator++( void ) {
-				if ( _ptr == NULL )
-					_ptr = _container->getFirst();
-				else if ( _ptr->right == NULL ) {
-					while (_ptr->isLeft == false && _ptr->parent )
-						_ptr = _ptr->parent;
-					if ( _ptr->parent )
-						_ptr = _ptr->parent;
-					else
-						_ptr = NULL;
-				}
-				else {
-					_ptr = _ptr->right;
-					while ( _ptr->left )
-						_ptr = _ptr->left;
-				}
+				_ptr = tree_increment( _ptr );
 				return *this;
 			}
 
@@ -274,21 +278,7 @@ namespace ft {
 			}
 
 			tree_iterator& operator--( void ) {
-				if ( _ptr == NULL )
-					_ptr = _container->getLast();
-				else if ( _ptr->left == NULL ) {
-					while ( _ptr->isLeft == true && _ptr->parent )
-						_ptr = _ptr->parent;
-					if ( _ptr->parent )
-						_ptr = _ptr->parent;
-					else
-						_ptr = NULL;
-				}
-				else {
-					_ptr = _ptr->left;
-					while ( _ptr->right )
-						_ptr = _ptr->right;
-				}
+				_ptr = tree_decrement( _ptr );
 				return *this;
 			}
 			
@@ -300,8 +290,7 @@ namespace ft {
 
 		private:
 
-			container_pointer _container;
-			tree_node<T> * _ptr;
+			tree_node_base * _ptr;
 
 	};
 
@@ -322,45 +311,37 @@ namespace ft {
 
 			/************************* Constructors and Destructor ***************************/
 
-			const_tree_iterator( void ) {}
-			const_tree_iterator( container_pointer container, tree_node<value_type>* ptr ) : _container( container ), _ptr( ptr ) {}
+			const_tree_iterator( void ) : _ptr( NULL ) {}
+			explicit const_tree_iterator( tree_node_base * ptr ) : _ptr( ptr ) {}
+			const_tree_iterator( tree_iterator<T, Container> const & it ) : _ptr( it.getNode() ) {}
 			const_tree_iterator( const_tree_iterator const & copy ) {
 				*this = copy;
 			}
 			~const_tree_iterator( void ) {}
 
+			/************************* Member Functions **************************************/
+
+			tree_node_base * getNode( void ) const {
+				return _ptr;
+			}
+
 			/************************* Implement operators ***********************************/
 
 			const_tree_iterator& operator=( const_tree_iterator const & rhs ) {
 				_ptr = rhs._ptr;
-				_container = rhs._container;
 				return *this;
 			}
 
 			const_reference operator*( void ) const {
-				return _ptr->value;
+				return static_cast< tree_node<T>* >( _ptr )->value;
 			}
 
-			const_pointer operator->( void ) {
-				return &_ptr->value;
+			const_pointer operator->( void ) const {
+				return &static_cast< tree_node<T>* >( _ptr )->value;
 			}
 
 			const_tree_iterator& operator++( void ) {
-				if ( _ptr == NULL )
-					_ptr = _container->getFirst();
-				else if ( _ptr->right == NULL ) {
-					while ( _ptr->isLeft == false && _ptr->parent )
-						_ptr = _ptr->parent;
-					if ( _ptr->parent )
-						_ptr = _ptr->parent;
-					else
-						_ptr = NULL;
-				}
-				else {
-					_ptr = _ptr->right;
-					while ( _ptr->left )
-						_ptr = _ptr->left;
-				}
+				_ptr = tree_increment( _ptr );
 				return *this;
 			}
 			const_tree_iterator operator++( int ) {
@@ -369,21 +350,7 @@ namespace ft {
 				return tmp;
 			}
 			const_tree_iterator& operator--( void ) {
-				if ( _ptr == NULL )
-					_ptr = _container->getLast();
-				else if ( _ptr->left == NULL ) {
-					while ( _ptr->isLeft  == true && _ptr->parent )
-						_ptr = _ptr->parent;
-					if ( _ptr->parent )
-						_ptr = _ptr->parent;
-					else
-						_ptr = NULL;
-				}
-				else {
-					_ptr = _ptr->left;
-					while ( _ptr->right )
-						_ptr = _ptr->right;
-				}
+				_ptr = tree_decrement( _ptr );
 				return *this;
 			}
 			const_tree_iterator operator--( int ) {
@@ -394,8 +361,7 @@ namespace ft {
 
 		private:
 
-			container_pointer _container;
-			tree_node<T> * _ptr;
+			tree_node_base * _ptr;
 
 	};
 
@@ -420,7 +386,8 @@ namespace ft {
 
 			reverse_iterator( void ) {}
 			explicit reverse_iterator( container_pointer ptr, long idx ) : _iter( ptr, idx ) {}
-			explicit reverse_iterator( container_pointer container, tree_node< value_type > * ptr ) : _iter( container, ptr ) {}
+			explicit reverse_iterator( tree_node_base * ptr ) : _iter( ptr ) {}
+			explicit reverse_iterator( Iter it ) : _iter( it ) {}
 			reverse_iterator( reverse_iterator<Iter> const & cpy ) { 
 				this->_iter = cpy._iter;
 			}
@@ -442,7 +409,7 @@ namespace ft {
 				return *_iter;
 			}
 			pointer operator->( void ) {
-				return &( *_iter );
+				return _iter.operator->();
 			}
 			reverse_iterator& operator++( void ) {
 				_iter--;
@@ -507,7 +474,8 @@ namespace ft {
 
 			const_reverse_iterator( void ) {}
 			explicit const_reverse_iterator( container_pointer ptr, long idx ) : _iter( ptr, idx ) {}
-			explicit const_reverse_iterator( container_pointer container, tree_node< value_type > * ptr ) : _iter( container, ptr ) {}
+			explicit const_reverse_iterator( tree_node_base * ptr ) : _iter( ptr ) {}
+			explicit const_reverse_iterator( ConstIter it ) : _iter( it ) {}
 			const_reverse_iterator( const_reverse_iterator<ConstIter> const & cpy ) { 
 				this->_iter = cpy._iter;
 			}
@@ -525,11 +493,11 @@ namespace ft {
 				this->_iter = rhs._iter;
 				return *this;
 			}
-			const value_type & operator*( void ) const {
+			typename ConstIter::const_reference operator*( void ) const {
 				return *_iter;
 			}
-			const value_type * operator->( void ) {
-				return &( *_iter );
+			typename ConstIter::const_pointer operator->( void ) {
+				return _iter.operator->();
 			}
 			const_reverse_iterator& operator++( void ) {
 				_iter--;
@@ -567,105 +535,105 @@ namespace ft {
 				this->_iter += n;
 				return *this;
 			}
-			value_type const & operator[]( size_t index ) const {
+			typename ConstIter::const_reference operator[]( size_t index ) const {
 				return *(this->_iter - index);
 			}
 	};
 
 	/************************* Non member function operators *********************************/
 
-	template <class T>
-	bool operator== ( iterator<T> const & lhs, iterator<T> const & rhs ) {
-		return &*lhs == &*rhs;
+	template <class T, class V>
+	bool operator== ( iterator<T, V> const & lhs, iterator<T, V> const & rhs ) {
+		return lhs.getIndex() == rhs.getIndex();
 	}
-	template <class T>
-	bool operator!= ( iterator<T> const & lhs, iterator<T> const & rhs ) {
-		return &*lhs != &*rhs;
+	template <class T, class V>
+	bool operator!= ( iterator<T, V> const & lhs, iterator<T, V> const & rhs ) {
+		return lhs.getIndex() != rhs.getIndex();
 	}
-	template <class T>
-	bool operator<( iterator<T> const & lhs, iterator<T> const & rhs ) {
-		return &*lhs < &*rhs;
+	template <class T, class V>
+	bool operator<( iterator<T, V> const & lhs, iterator<T, V> const & rhs ) {
+		return lhs.getIndex() < rhs.getIndex();
 	}
-	template <class T>
-	bool operator>( iterator<T> const & lhs, iterator<T> const & rhs ) {
-		return &*lhs > &*rhs;
+	template <class T, class V>
+	bool operator>( iterator<T, V> const & lhs, iterator<T, V> const & rhs ) {
+		return lhs.getIndex() > rhs.getIndex();
 	}
-	template <class T>
-	bool operator<=( iterator<T> const & lhs, iterator<T> const & rhs ) {
-		return &*lhs <= &*rhs;
+	template <class T, class V>
+	bool operator<=( iterator<T, V> const & lhs, iterator<T, V> const & rhs ) {
+		return lhs.getIndex() <= rhs.getIndex();
 	}
-	template <class T>
-	bool operator>=( iterator<T> const & lhs, iterator<T> const & rhs ) {
-		return &*lhs >= &*rhs;
+	template <class T, class V>
+	bool operator>=( iterator<T, V> const & lhs, iterator<T, V> const & rhs ) {
+		return lhs.getIndex() >= rhs.getIndex();
 	}
 	template <class T>
 	iterator<T> operator+( typename iterator<T>::difference_type n, iterator<T> const & rev_it ) {
 		return rev_it + n;
 	}
-	template <class T>
-	typename iterator<T>::difference_type operator-( iterator<T> const & lhs, iterator<T> const & rhs ) {
-		return &*lhs - &*rhs;
+	template <class T, class V>
+	typename iterator<T, V>::difference_type operator-( iterator<T, V> const & lhs, iterator<T, V> const & rhs ) {
+		return lhs.getIndex() - rhs.getIndex();
 	}
 
 
-	template <class T>
-	bool operator== ( const_iterator<T> const & lhs, const_iterator<T> const & rhs ) {
-		return &*lhs == &*rhs;
+	template <class T, class V>
+	bool operator== ( const_iterator<T, V> const & lhs, const_iterator<T, V> const & rhs ) {
+		return lhs.getIndex() == rhs.getIndex();
 	}
-	template <class T>
-	bool operator!= ( const_iterator<T> const & lhs, const_iterator<T> const & rhs ) {
-		return &*lhs != &*rhs;
+	template <class T, class V>
+	bool operator!= ( const_iterator<T, V> const & lhs, const_iterator<T, V> const & rhs ) {
+		return lhs.getIndex() != rhs.getIndex();
 	}
-	template <class T>
-	bool operator<( const_iterator<T> const & lhs, const_iterator<T> const & rhs ) {
-		return &*lhs < &*rhs;
+	template <class T, class V>
+	bool operator<( const_iterator<T, V> const & lhs, const_iterator<T, V> const & rhs ) {
+		return lhs.getIndex() < rhs.getIndex();
 	}
-	template <class T>
-	bool operator>( const_iterator<T> const & lhs, const_iterator<T> const & rhs ) {
-		return &*lhs > &*rhs;
+	template <class T, class V>
+	bool operator>( const_iterator<T, V> const & lhs, const_iterator<T, V> const & rhs ) {
+		return lhs.getIndex() > rhs.getIndex();
 	}
-	template <class T>
-	bool operator<=( const_iterator<T> const & lhs, const_iterator<T> const & rhs ) {
-		return &*lhs <= &*rhs;
+	template <class T, class V>
+	bool operator<=( const_iterator<T, V> const & lhs, const_iterator<T, V> const & rhs ) {
+		return lhs.getIndex() <= rhs.getIndex();
 	}
-	template <class T>
-	bool operator>=( const_iterator<T> const & lhs, const_iterator<T> const & rhs ) {
-		return &*lhs >= &*rhs;
+	template <class T, class V>
+	bool operator>=( const_iterator<T, V> const & lhs, const_iterator<T, V> const & rhs ) {
+		return lhs.getIndex() >= rhs.getIndex();
 	}
 	template <class T>
 	const_iterator<T> operator+( typename const_iterator<T>::difference_type n, const_iterator<T> const & rev_it ) {
 		return rev_it + n;
 	}
-	template <class T>
-	typename const_iterator<T>::difference_type operator-( const_iterator<T> const & lhs, const_iterator<T> const & rhs ) {
-		return &*lhs - &*rhs;
+	template <class T, class V>
+	typename const_iterator<T, V>::difference_type operator-( const_iterator<T, V> const & lhs, const_iterator<T, V> const & rhs ) {
+		return lhs.getIndex() - rhs.getIndex();
 	}
 
 	template <class T, class Container>
 	bool operator==( tree_iterator<T, Container> const & lhs, tree_iterator<T, Container> const & rhs ) {
-		return &*lhs == &*rhs;
+		return lhs.getNode() == rhs.getNode();
 	}
 	template <class T, class Container>
 	bool operator!=( tree_iterator<T, Container> const & lhs, tree_iterator<T, Container> const & rhs ) {
-		return &*lhs != &*rhs;
+		return lhs.getNode() != rhs.getNode();
 	}
 
 	template <class T, class Container>
 	bool operator==( const_tree_iterator<T, Container> const & lhs, const_tree_iterator<T, Container> const & rhs ) {
-		return &*lhs == &*rhs;
+		return lhs.getNode() == rhs.getNode();
 	}
 	template <class T, class Container>
 	bool operator!=( const_tree_iterator<T, Container> const & lhs, const_tree_iterator<T, Container> const & rhs ) {
-		return &*lhs != &*rhs;
+		return lhs.getNode() != rhs.getNode();
 	}
 
 	template <class Iter>
 	bool operator==( reverse_iterator<Iter> const & lhs, reverse_iterator<Iter> const & rhs ) {
-		return &*lhs == &*rhs;
+		return lhs.base() == rhs.base();
 	}
 	template <class Iter>
 	bool operator!=( reverse_iterator<Iter> const & lhs, reverse_iterator<Iter> const & rhs ) {
-		return &*lhs != &*rhs;
+		return lhs.base() != rhs.base();
 	}
 	template <class Iter>
 	bool operator<( reverse_iterator<Iter> const & lhs, reverse_iterator<Iter> const & rhs ) {
@@ -695,11 +663,11 @@ namespace ft {
 
 	template <class ConstIter>
 	bool operator==( const_reverse_iterator<ConstIter> const & lhs, const_reverse_iterator<ConstIter> const & rhs ) {
-		return &*lhs == &*rhs;
+		return lhs.base() == rhs.base();
 	}
 	template <class ConstIter>
 	bool operator!=( const_reverse_iterator<ConstIter> const & lhs, const_reverse_iterator<ConstIter> const & rhs ) {
-		return &*lhs != &*rhs;
+		return lhs.base() != rhs.base();
 	}
 	template <class ConstIter>
 	bool operator<( const_reverse_iterator<ConstIter> const & lhs, const_reverse_iterator<ConstIter> const & rhs ) {
@@ -2,11 +2,33 @@
 #define MAP_HPP
 
 #include "tree.hpp"
-#include "stack.hpp"
 
 namespace ft {
 
-	template < class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator< pair< const Key, T > > >
+	// node handle of the maps: key() and mapped() on top of value()
+	template <class T, class Alloc, class Node>
+	class map_node_handle : public tree_node_handle< T, Alloc, Node > {
+
+		public:
+
+			typedef typename T::first_type		key_type;
+			typedef typename T::second_type		mapped_type;
+
+			map_node_handle( void ) {}
+
+			map_node_handle( Node* node, const Alloc& alloc ) : tree_node_handle< T, Alloc, Node >( node, alloc ) {}
+
+			key_type& key( void ) const {
+				return this->value().first;
+			}
+
+			mapped_type& mapped( void ) const {
+				return this->value().second;
+			}
+
+	};
+
+	template < class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator< pair< const Key, T > >, class Nodes = plain_nodes >
 	class map {
 
 		private:
@@ -23,24 +45,30 @@ namespace ft {
 			typedef value_comp																			value_compare;
 			typedef pair< key_type, mapped_type >														value_type;
 			typedef Alloc																				allocator_type;
-			typedef typename allocator_type::template rebind< tree_node< value_type > >::other			new_alloc;
+			typedef typename Nodes::template rebind< value_type >::other									tree_node_type;
+			typedef typename allocator_type::template rebind< tree_node_type >::other					new_alloc;
 			typedef typename allocator_type::reference													reference;
 			typedef typename allocator_type::const_reference											const_reference;
 			typedef typename allocator_type::pointer													pointer;
 			typedef typename allocator_type::const_pointer												const_pointer;
-			typedef tree_iterator< value_type, ft::tree< value_type, value_compare, new_alloc > >		iterator;
-			typedef const_tree_iterator< value_type, ft::tree< value_type, value_compare, new_alloc > >	const_iterator;
+			typedef tree_iterator< value_type, ft::tree< value_type, value_compare, new_alloc, tree_node_type > >		iterator;
+			typedef const_tree_iterator< value_type, ft::tree< value_type, value_compare, new_alloc, tree_node_type > >	const_iterator;
 			typedef reverse_iterator<iterator>															reverse_iterator;
 			typedef const_reverse_iterator<const_iterator>												const_reverse_iterator;
+			typedef map_node_handle< value_type, new_alloc, tree_node_type >							node_type;
+			typedef typename tree_node_type::aggregate_type												aggregate_type;
 			typedef std::ptrdiff_t																		difference_type;
 			typedef size_t																				size_type;
 
 		private:
 
+			// keys find_batch hands to the tree at a time
+			static const size_type batch_size = 256;
+
 			key_compare _kcomparer;
 			value_compare _vcomparer;
 			allocator_type _allocator;
-			tree< value_type, value_compare, new_alloc > _tree;
+			tree< value_type, value_compare, new_alloc, tree_node_type > _tree;
 
 		public:
 
@@ -82,35 +110,27 @@ namespace ft {
 			}
 
 			iterator end( void ) {
-				if ( _tree.getLast() )
-					return _tree.end();
-				return begin();
+				return _tree.end();
 			}
 
 			const_iterator end( void ) const {
-				if ( _tree.getLast() )
-					return _tree.end();
-				return begin();
+				return _tree.end();
 			}
 
 			reverse_iterator rbegin( void ) {
-				return reverse_iterator( &_tree, _tree.getLast() );
+				return _tree.rbegin();
 			}
 
 			const_reverse_iterator rbegin( void ) const {
-				return const_reverse_iterator( &_tree, _tree.getLast() );
+				return _tree.rbegin();
 			}
 
 			reverse_iterator rend( void ) {
-				if ( _tree.getFirst() )
-					return reverse_iterator( &_tree, _tree.getFirst()->left );
-				return rbegin();
+				return _tree.rend();
 			}
 
 			const_reverse_iterator rend( void ) const {
-				if ( _tree.getFirst() )
-					return const_reverse_iterator( &_tree, _tree.getFirst()->left );
-				return rbegin();
+				return _tree.rend();
 			}
 
 			/************************************* Capacity ******************************************/
@@ -130,13 +150,7 @@ namespace ft {
 			/************************************* Element access ************************************/
 
 			mapped_type& operator[]( const key_type& k ) {
-				bool duplicate = false;
-				tree_node<value_type>* res = _tree.add( ft::make_pair< key_type, mapped_type >( k, mapped_type() ), &duplicate );
-				return res->value.second;
-				// tree_node<value_type>* res = _tree.search( _tree.getRoot(), ft::make_pair< key_type, mapped_type >( k, mapped_type() ) );
-				// if ( res )
-				// 	return res->value.second;
-				// return _tree.add( ft::make_pair< key_type, mapped_type >( k, mapped_type() ) )->value.second;
+				return try_emplace( k ).first->second;
 			}
 
 			/************************************* Modifiers *****************************************/
@@ -144,49 +158,69 @@ namespace ft {
 			pair<iterator, bool> insert( const value_type& val ) {
 				bool duplicate = false;
 				tree_node< value_type >* res = _tree.add( val, &duplicate );
-				iterator it ( &_tree, res );
+				iterator it ( res );
 				return ft::make_pair<iterator, bool>( it, !duplicate );
 			}
 
+			// O(1) amortized when val goes right before or right after position
 			iterator insert( iterator position, const value_type& val ) {
 				bool duplicate = false;
-				tree_node< value_type > *walk, *node;
-				node = _tree.search( _tree.getRoot(), *position );
-				if ( node == NULL || node == _tree.getRoot() )
-					return insert( val ).first;
-				walk = node->parent;
-				if ( _vcomparer( val, node->value ) ) {
-					if ( !node->isLeft && _vcomparer( val, walk->value ) )
-						return insert( val ).first;
-					else if ( node->isLeft ) 
-						return iterator( &_tree, _tree.hint_add( node, val, &duplicate ) );
-				}
-				else {
-					if ( node->isLeft && _vcomparer( walk->value, val ) )
-						return insert( val ).first;
-					else if ( !node->isLeft )
-						return iterator( &_tree, _tree.hint_add( node, val, &duplicate ) );
+				return iterator( _tree.hint_add( position.getNode(), val, &duplicate ) );
+			}
+
+			/*
+			** Insert k unless it is already there, the mapped value is only built
+			** (from obj, or by default) when a node is created.
+			*/
+			pair<iterator, bool> try_emplace( const key_type& k ) {
+				tree_node_base* parent;
+				bool left;
+				tree_node< value_type >* node = _tree.find_slot( k, key_value_comp<key_type>( _kcomparer ), &parent, &left );
+				if ( node )
+					return ft::make_pair( iterator( node ), false );
+				return ft::make_pair( iterator( _tree.add_at( parent, left, value_type( k, mapped_type() ) ) ), true );
+			}
+
+			template <class M>
+			pair<iterator, bool> try_emplace( const key_type& k, const M& obj ) {
+				tree_node_base* parent;
+				bool left;
+				tree_node< value_type >* node = _tree.find_slot( k, key_value_comp<key_type>( _kcomparer ), &parent, &left );
+				if ( node )
+					return ft::make_pair( iterator( node ), false );
+				return ft::make_pair( iterator( _tree.add_at( parent, left, value_type( k, obj ) ) ), true );
+			}
+
+			// assigns obj to the value of k if there is one, inserts it otherwise
+			template <class M>
+			pair<iterator, bool> insert_or_assign( const key_type& k, const M& obj ) {
+				tree_node_base* parent;
+				bool left;
+				tree_node< value_type >* node = _tree.find_slot( k, key_value_comp<key_type>( _kcomparer ), &parent, &left );
+				if ( node ) {
+					node->value.second = obj;
+					_tree.refresh( node );
+					return ft::make_pair( iterator( node ), false );
 				}
-				return iterator( &_tree, _tree.hint_add( node, val, &duplicate ) );
+				return ft::make_pair( iterator( _tree.add_at( parent, left, value_type( k, obj ) ) ), true );
 			}
 
 			template <class InputIterator>
 			void insert( InputIterator first, InputIterator last ) {
 				while ( first != last ) {
-					insert( *first );
+					insert( end(), *first );
 					first++;
 				}
 			}
 
 			void erase( iterator position ) {
-				tree_node< value_type > *node = _tree.search( _tree.getRoot(), *position );
-				if ( node == NULL )
+				if ( position == end() )
 					return ;
-				_tree.del( node );
+				_tree.del( static_cast< tree_node< value_type >* >( position.getNode() ) );
 			}
 
 			size_type erase( const key_type& k ) {
-				tree_node< value_type >* res = _tree.search( _tree.getRoot(), ft::make_pair<key_type, mapped_type>( k, mapped_type() ) );
+				tree_node< value_type >* res = find_node( k );
 				if ( res ) {
 					_tree.del( res );
 					return 1;
@@ -195,15 +229,7 @@ namespace ft {
 			}
 
 			void erase( iterator first, iterator last ) {
-				ft::stack<key_type> a;
-				while ( first != last ) {
-					a.push( first->first );
-					first++;
-				}
-				while ( !a.empty() ) {
-					erase( a.top() );
-					a.pop();
-				}
+				_tree.del_range( first.getNode(), last.getNode() );
 			}
 
 			void swap( map& x ) {
@@ -214,6 +240,58 @@ namespace ft {
 				_tree.clear();
 			}
 
+			/************************************* Node handles **************************************/
+
+			// unlinks the element, the iterators to the others stay valid
+			node_type extract( iterator position ) {
+				tree_node< value_type >* node = static_cast< tree_node< value_type >* >( position.getNode() );
+				return node_type( static_cast< tree_node_type* >( _tree.extract( node ) ), _tree.getAllocator() );
+			}
+
+			node_type extract( const key_type& k ) {
+				tree_node< value_type >* node = find_node( k );
+				if ( node == NULL )
+					return node_type();
+				return node_type( static_cast< tree_node_type* >( _tree.extract( node ) ), _tree.getAllocator() );
+			}
+
+			// links the node of nh unless its key is already there, it then stays in nh
+			pair<iterator, bool> insert( const node_type& nh ) {
+				if ( nh.empty() )
+					return ft::make_pair( end(), false );
+				tree_node_base* parent;
+				bool left;
+				tree_node< value_type >* node = _tree.find_slot( nh.key(), key_value_comp<key_type>( _kcomparer ), &parent, &left );
+				if ( node )
+					return ft::make_pair( iterator( node ), false );
+				if ( nh.get_allocator() == _tree.getAllocator() )
+					return ft::make_pair( iterator( _tree.link_at( parent, left, nh.release() ) ), true );
+				node = _tree.add_at( parent, left, nh.value() );
+				nh.reset();
+				return ft::make_pair( iterator( node ), true );
+			}
+
+			// moves over the elements of source whose key is not here yet
+			void merge( map& source ) {
+				_tree.merge( source._tree );
+			}
+
+			/************************************* Set algebra ***************************************/
+
+			// Node reusing set operations, x is left empty.
+
+			void set_union( map& x ) {
+				_tree.set_union( x._tree );
+			}
+
+			void set_intersection( map& x ) {
+				_tree.set_intersection( x._tree );
+			}
+
+			void set_difference( map& x ) {
+				_tree.set_difference( x._tree );
+			}
+
 			/************************************* Observers *****************************************/
 
 			key_compare key_comp( void ) const {
@@ -225,71 +303,187 @@ namespace ft {
 			}
 
 			/************************************* Operations ****************************************/
-			
+
 			iterator find( const key_type& k ) {
-				return iterator( &_tree, _tree.search( _tree.getRoot(), ft::make_pair<key_type, mapped_type>( k, mapped_type() ) ) );
+				return to_iterator( find_node( k ) );
 			}
 
 			const_iterator find( const key_type& k ) const {
-				return const_iterator( &_tree, _tree.search( _tree.getRoot(), ft::make_pair<key_type, mapped_type>( k, mapped_type() ) ) );
+				return to_iterator( find_node( k ) );
 			}
 
 			size_type count( const key_type& k ) const {
-				if ( _tree.search( _tree.getRoot(), ft::make_pair<key_type, mapped_type>( k, mapped_type() ) ) )
-					return 1;
-				return 0;
+				return find_node( k ) ? 1 : 0;
 			}
 
 			iterator lower_bound( const key_type& k ) {
-				tree_node< value_type >* node = _tree.lower_search( _tree.getRoot(), ft::make_pair<key_type, mapped_type>( k, mapped_type() ) );
-				if ( node )
-					return iterator( &_tree, node );
-				return end();
+				return to_iterator( lower_node( k ) );
 			}
 
 			const_iterator lower_bound( const key_type& k ) const {
-				tree_node< value_type >* node = _tree.lower_search( _tree.getRoot(), ft::make_pair<key_type, mapped_type>( k, mapped_type() ) );
-				if ( node )
-					return iterator( &_tree, node );
-				return end();
+				return to_iterator( lower_node( k ) );
 			}
 
 			iterator upper_bound( const key_type& k ) {
-				tree_node< value_type >* node = _tree.lower_search( _tree.getRoot(), ft::make_pair<key_type, mapped_type>( k, mapped_type() ) );
-				if ( node ) {
-					if ( !_kcomparer( k, node->value.first ) && !_kcomparer( node->value.first, k ) )
-						return ++iterator( &_tree, node );
-					return iterator( &_tree, node );
-				}
-				return end();
+				return to_iterator( upper_node( k ) );
 			}
 
 			const_iterator upper_bound( const key_type& k ) const {
-				tree_node< value_type >* node = _tree.lower_search( _tree.getRoot(), ft::make_pair<key_type, mapped_type>( k, mapped_type() ) );
-				if ( node ) {
-					if ( !_kcomparer( k, node->value.first ) && !_kcomparer( node->value.first, k ) )
-						return ++const_iterator( &_tree, node );
-					return const_iterator( &_tree, node );
-				}
-				return end();
+				return to_iterator( upper_node( k ) );
 			}
 
 			pair<iterator,iterator> equal_range( const key_type& k ) {
-				tree_node< value_type >* node = _tree.lower_search( _tree.getRoot(), ft::make_pair<key_type, mapped_type>( k, mapped_type() ) );
-				if ( node ) {
-					if ( !_kcomparer( k, node->value.first ) && !_kcomparer( node->value.first, k ) )
-						return ft::make_pair<iterator,iterator>( iterator( &_tree, node ), ++iterator( &_tree, node ) );
+				return ft::make_pair( lower_bound( k ), upper_bound( k ) );
+			}
+
+			pair<const_iterator,const_iterator> equal_range( const key_type& k ) const {
+				return ft::make_pair( lower_bound( k ), upper_bound( k ) );
+			}
+
+			/*
+			** find for keys[0] up to keys[n - 1] into out[0] up to out[n - 1].
+			** The descents are interleaved so their cache misses overlap, which
+			** pays off once the tree no longer fits in the cache.
+			*/
+			void find_batch( const key_type* keys, size_type n, iterator* out ) {
+				tree_node< value_type >* nodes[batch_size];
+				for ( size_type i = 0; i < n; i += batch_size ) {
+					size_type m = ( n - i < batch_size ) ? n - i : batch_size;
+					_tree.search_batch( keys + i, m, key_value_comp<key_type>( _kcomparer ), nodes );
+					for ( size_type j = 0; j < m; j++ )
+						out[i + j] = to_iterator( nodes[j] );
 				}
-				return ft::make_pair<iterator,iterator>( iterator( &_tree, node ), iterator( &_tree, node ) );
 			}
 
-			pair<const_iterator,const_iterator> equal_range (const key_type& k) const {
-				tree_node< value_type >* node = _tree.lower_search( _tree.getRoot(), ft::make_pair<key_type, mapped_type>( k, mapped_type() ) );
-				if ( node ) {
-					if ( !_kcomparer( k, node->value.first ) && !_kcomparer( node->value.first, k ) )
-						return ft::make_pair<const_iterator,const_iterator>( const_iterator( &_tree, node ), ++const_iterator( &_tree, node ) );
+			void find_batch( const key_type* keys, size_type n, const_iterator* out ) const {
+				tree_node< value_type >* nodes[batch_size];
+				for ( size_type i = 0; i < n; i += batch_size ) {
+					size_type m = ( n - i < batch_size ) ? n - i : batch_size;
+					_tree.search_batch( keys + i, m, key_value_comp<key_type>( _kcomparer ), nodes );
+					for ( size_type j = 0; j < m; j++ )
+						out[i + j] = to_iterator( nodes[j] );
 				}
-				return ft::make_pair<const_iterator,const_iterator>( const_iterator( &_tree, node ), const_iterator( &_tree, node ) );
+			}
+
+			/*
+			** find for every key of [first, last), which must be sorted, into
+			** out. Each search resumes from where the previous one ended, so a
+			** dense run of m keys costs O(m log(n / m)) instead of O(m log n).
+			*/
+			template <class InputIterator, class OutputIterator>
+			OutputIterator find_sorted( InputIterator first, InputIterator last, OutputIterator out ) {
+				tree_node_base* finger = begin().getNode();
+				for ( ; first != last; ++first, ++out )
+					*out = to_iterator( _tree.finger_search( &finger, key_type( *first ), key_value_comp<key_type>( _kcomparer ) ) );
+				return out;
+			}
+
+			template <class InputIterator, class OutputIterator>
+			OutputIterator find_sorted( InputIterator first, InputIterator last, OutputIterator out ) const {
+				tree_node_base* finger = begin().getNode();
+				for ( ; first != last; ++first, ++out )
+					*out = to_iterator( _tree.finger_search( &finger, key_type( *first ), key_value_comp<key_type>( _kcomparer ) ) );
+				return out;
+			}
+
+			/*
+			** Lookups by any type the comparator can order against key_type,
+			** only available with a transparent comparator such as ft::less<>:
+			** a map<std::string, ..., ft::less<> > can be searched with a const
+			** char* without building a std::string.
+			*/
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type find( const K& k ) {
+				return to_iterator( find_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type find( const K& k ) const {
+				return to_iterator( find_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, size_type >::type count( const K& k ) const {
+				return find_node( k ) ? 1 : 0;
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type lower_bound( const K& k ) {
+				return to_iterator( lower_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type lower_bound( const K& k ) const {
+				return to_iterator( lower_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type upper_bound( const K& k ) {
+				return to_iterator( upper_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type upper_bound( const K& k ) const {
+				return to_iterator( upper_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, pair<iterator,iterator> >::type equal_range( const K& k ) {
+				return ft::make_pair( to_iterator( lower_node( k ) ), to_iterator( upper_node( k ) ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, pair<const_iterator,const_iterator> >::type equal_range( const K& k ) const {
+				return ft::make_pair( to_iterator( lower_node( k ) ), to_iterator( upper_node( k ) ) );
+			}
+
+			/************************************* Order statistics **********************************/
+
+			// O(log n) with ft::ranked_nodes, linear otherwise
+
+			iterator nth( size_type n ) {
+				tree_node< value_type >* node = _tree.select( n );
+				if ( node )
+					return iterator( node );
+				return end();
+			}
+
+			const_iterator nth( size_type n ) const {
+				tree_node< value_type >* node = _tree.select( n );
+				if ( node )
+					return const_iterator( node );
+				return end();
+			}
+
+			size_type rank( const key_type& k ) const {
+				return _tree.rank( k, key_value_comp<key_type>( _kcomparer ) );
+			}
+
+			difference_type distance( const_iterator first, const_iterator last ) const {
+				return _tree.distance( first.getNode(), last.getNode() );
+			}
+
+			/************************************* Aggregates ****************************************/
+
+			// only with ft::aggregate_nodes, whose Monoid gives the type and the operations
+
+			// aggregate of the values whose key is in [lo, hi), O(log n). A value
+			// written through operator[] or an iterator is not counted as written
+			// until refresh() is called on it; insert_or_assign refreshes by itself
+			aggregate_type aggregate( const key_type& lo, const key_type& hi ) const {
+				return _tree.aggregate( lo, hi, key_value_comp<key_type>( _kcomparer ) );
+			}
+
+			// aggregate of every value, O(1), with the same caveat on stale values
+			aggregate_type aggregate( void ) const {
+				return _tree.aggregate();
+			}
+
+			// to call after changing a value through an iterator or operator[],
+			// before the next aggregate(), O(log n)
+			void refresh( iterator position ) {
+				_tree.refresh( position.getNode() );
 			}
 
 			/************************************* Allocator *****************************************/
@@ -299,6 +493,51 @@ namespace ft {
 			}
 
 		private:
+
+			// orders a key of type K against the key of a value
+			template <class K>
+			class key_value_comp {
+
+				public:
+
+					key_value_comp( const key_compare& comp ) : _comp( comp ) {}
+
+					bool operator()( const value_type& x, const K& k ) const {
+						return _comp( x.first, k );
+					}
+
+					bool operator()( const K& k, const value_type& x ) const {
+						return _comp( k, x.first );
+					}
+
+				private:
+
+					key_compare _comp;
+
+			};
+
+			template <class K>
+			tree_node< value_type >* find_node( const K& k ) const {
+				return _tree.search( _tree.getRoot(), k, key_value_comp<K>( _kcomparer ) );
+			}
+
+			template <class K>
+			tree_node< value_type >* lower_node( const K& k ) const {
+				return _tree.lower_search( _tree.getRoot(), k, key_value_comp<K>( _kcomparer ) );
+			}
+
+			template <class K>
+			tree_node< value_type >* upper_node( const K& k ) const {
+				return _tree.upper_search( _tree.getRoot(), k, key_value_comp<K>( _kcomparer ) );
+			}
+
+			iterator to_iterator( tree_node< value_type >* node ) {
+				return node ? iterator( node ) : end();
+			}
+
+			const_iterator to_iterator( tree_node< value_type >* node ) const {
+				return node ? const_iterator( node ) : end();
+			}
 			
 			void printBT( void ) {
 				_tree.printBT( "", _tree.getRoot(), false );
@@ -0,0 +1,419 @@
+#ifndef MULTIMAP_HPP
+#define MULTIMAP_HPP
+
+#include "tree.hpp"
+
+namespace ft {
+
+	/*
+	** ft::map allowing several values with the same key, on the same tree:
+	** values with equal keys stay in insertion order, each new one going
+	** after the others unless a hint puts it elsewhere in its run.
+	*/
+	template < class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator< pair< const Key, T > >, class Nodes = plain_nodes >
+	class multimap {
+
+		private:
+
+			class value_comp;
+
+		public:
+
+			/************************************* Typedefs ******************************************/
+
+			typedef Key																					key_type;
+			typedef T																					mapped_type;
+			typedef Compare																				key_compare;
+			typedef value_comp																			value_compare;
+			typedef pair< key_type, mapped_type >														value_type;
+			typedef Alloc																				allocator_type;
+			typedef typename Nodes::template rebind< value_type >::other									tree_node_type;
+			typedef typename allocator_type::template rebind< tree_node_type >::other					new_alloc;
+			typedef typename allocator_type::reference													reference;
+			typedef typename allocator_type::const_reference											const_reference;
+			typedef typename allocator_type::pointer													pointer;
+			typedef typename allocator_type::const_pointer												const_pointer;
+			typedef tree_iterator< value_type, ft::tree< value_type, value_compare, new_alloc, tree_node_type > >		iterator;
+			typedef const_tree_iterator< value_type, ft::tree< value_type, value_compare, new_alloc, tree_node_type > >	const_iterator;
+			typedef reverse_iterator<iterator>															reverse_iterator;
+			typedef const_reverse_iterator<const_iterator>												const_reverse_iterator;
+			typedef std::ptrdiff_t																		difference_type;
+			typedef size_t																				size_type;
+
+		private:
+
+			key_compare _kcomparer;
+			value_compare _vcomparer;
+			allocator_type _allocator;
+			tree< value_type, value_compare, new_alloc, tree_node_type > _tree;
+
+		public:
+
+			/************************************* Constructors **************************************/
+
+			explicit multimap( const key_compare& comp = key_compare(), const new_alloc& alloc = new_alloc() )
+			: _kcomparer( comp ), _vcomparer( comp ), _allocator( alloc ), _tree( _vcomparer, alloc ) {}
+
+			// sorted input is appended without any search
+			template <class InputIterator>
+			multimap( InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const new_alloc& alloc = new_alloc() )
+			: _kcomparer( comp ), _vcomparer( comp ), _allocator( alloc ), _tree( _vcomparer, alloc ) {
+				insert( first, last );
+			}
+
+			multimap( const multimap& x ) {
+				*this = x;
+			}
+
+			/************************************* Destructor ****************************************/
+
+			~multimap( void ) {}
+
+			/************************************* Operator = ****************************************/
+
+			multimap& operator=( const multimap& x ) {
+				_tree = x._tree;
+				_vcomparer = x._vcomparer;
+				_kcomparer = x._kcomparer;
+				_allocator = x._allocator;
+				return *this;
+			}
+
+			/************************************* Iterators *****************************************/
+
+			iterator begin( void ) {
+				return _tree.begin();
+			}
+
+			const_iterator begin( void ) const {
+				return _tree.begin();
+			}
+
+			iterator end( void ) {
+				return _tree.end();
+			}
+
+			const_iterator end( void ) const {
+				return _tree.end();
+			}
+
+			reverse_iterator rbegin( void ) {
+				return _tree.rbegin();
+			}
+
+			const_reverse_iterator rbegin( void ) const {
+				return _tree.rbegin();
+			}
+
+			reverse_iterator rend( void ) {
+				return _tree.rend();
+			}
+
+			const_reverse_iterator rend( void ) const {
+				return _tree.rend();
+			}
+
+			/************************************* Capacity ******************************************/
+
+			bool empty( void ) const {
+				return ( _tree.getSize() == 0 ) ? true : false;
+			}
+
+			size_type size( void ) const {
+				return _tree.getSize();
+			}
+
+			size_type max_size( void ) const {
+				return _tree.getAllocator().max_size();
+			}
+
+			/************************************* Modifiers *****************************************/
+
+			iterator insert( const value_type& val ) {
+				return iterator( _tree.add_equal( val, false ) );
+			}
+
+			// O(1) amortized when val fits right before position, e.g. at the upper bound of its key
+			iterator insert( iterator position, const value_type& val ) {
+				return iterator( _tree.hint_add_equal( position.getNode(), val ) );
+			}
+
+			template <class InputIterator>
+			void insert( InputIterator first, InputIterator last ) {
+				while ( first != last ) {
+					insert( end(), *first );
+					first++;
+				}
+			}
+
+			void erase( iterator position ) {
+				if ( position == end() )
+					return ;
+				_tree.del( static_cast< tree_node< value_type >* >( position.getNode() ) );
+			}
+
+			// erases every value with key k
+			size_type erase( const key_type& k ) {
+				pair<iterator,iterator> range = equal_range( k );
+				size_type n = _tree.distance( range.first.getNode(), range.second.getNode() );
+				_tree.del_range( range.first.getNode(), range.second.getNode() );
+				return n;
+			}
+
+			void erase( iterator first, iterator last ) {
+				_tree.del_range( first.getNode(), last.getNode() );
+			}
+
+			void swap( multimap& x ) {
+				_tree.swap( x._tree );
+			}
+
+			void clear( void ) {
+				_tree.clear();
+			}
+
+			/************************************* Observers *****************************************/
+
+			key_compare key_comp( void ) const {
+				return _kcomparer;
+			}
+
+			value_compare value_comp( void ) const {
+				return _vcomparer;
+			}
+
+			/************************************* Operations ****************************************/
+
+			iterator find( const key_type& k ) {
+				return to_iterator( find_node( k ) );
+			}
+
+			const_iterator find( const key_type& k ) const {
+				return to_iterator( find_node( k ) );
+			}
+
+			// O(log n + count), O(log n) with ft::ranked_nodes
+			size_type count( const key_type& k ) const {
+				return count_values( k );
+			}
+
+			iterator lower_bound( const key_type& k ) {
+				return to_iterator( lower_node( k ) );
+			}
+
+			const_iterator lower_bound( const key_type& k ) const {
+				return to_iterator( lower_node( k ) );
+			}
+
+			iterator upper_bound( const key_type& k ) {
+				return to_iterator( upper_node( k ) );
+			}
+
+			const_iterator upper_bound( const key_type& k ) const {
+				return to_iterator( upper_node( k ) );
+			}
+
+			pair<iterator,iterator> equal_range( const key_type& k ) {
+				tree_node< value_type >* lower;
+				tree_node< value_type >* upper;
+				equal_nodes( k, &lower, &upper );
+				return ft::make_pair( to_iterator( lower ), to_iterator( upper ) );
+			}
+
+			pair<const_iterator,const_iterator> equal_range( const key_type& k ) const {
+				tree_node< value_type >* lower;
+				tree_node< value_type >* upper;
+				equal_nodes( k, &lower, &upper );
+				return ft::make_pair( to_iterator( lower ), to_iterator( upper ) );
+			}
+
+			/*
+			** Lookups by any type the comparator can order against key_type,
+			** only available with a transparent comparator such as ft::less<>:
+			** a multimap<std::string, ..., ft::less<> > can be searched with a const
+			** char* without building a std::string.
+			*/
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type find( const K& k ) {
+				return to_iterator( find_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type find( const K& k ) const {
+				return to_iterator( find_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, size_type >::type count( const K& k ) const {
+				return count_values( k );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type lower_bound( const K& k ) {
+				return to_iterator( lower_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type lower_bound( const K& k ) const {
+				return to_iterator( lower_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type upper_bound( const K& k ) {
+				return to_iterator( upper_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type upper_bound( const K& k ) const {
+				return to_iterator( upper_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, pair<iterator,iterator> >::type equal_range( const K& k ) {
+				tree_node< value_type >* lower;
+				tree_node< value_type >* upper;
+				equal_nodes( k, &lower, &upper );
+				return ft::make_pair( to_iterator( lower ), to_iterator( upper ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, pair<const_iterator,const_iterator> >::type equal_range( const K& k ) const {
+				tree_node< value_type >* lower;
+				tree_node< value_type >* upper;
+				equal_nodes( k, &lower, &upper );
+				return ft::make_pair( to_iterator( lower ), to_iterator( upper ) );
+			}
+
+			/************************************* Order statistics **********************************/
+
+			// O(log n) with ft::ranked_nodes, linear otherwise
+
+			iterator nth( size_type n ) {
+				tree_node< value_type >* node = _tree.select( n );
+				if ( node )
+					return iterator( node );
+				return end();
+			}
+
+			const_iterator nth( size_type n ) const {
+				tree_node< value_type >* node = _tree.select( n );
+				if ( node )
+					return const_iterator( node );
+				return end();
+			}
+
+			size_type rank( const key_type& k ) const {
+				return _tree.rank( k, key_value_comp<key_type>( _kcomparer ) );
+			}
+
+			difference_type distance( const_iterator first, const_iterator last ) const {
+				return _tree.distance( first.getNode(), last.getNode() );
+			}
+
+			/************************************* Allocator *****************************************/
+
+			allocator_type get_allocator( void ) const {
+				return _allocator;
+			}
+
+		private:
+
+			// orders a key of type K against the key of a value
+			template <class K>
+			class key_value_comp {
+
+				public:
+
+					key_value_comp( const key_compare& comp ) : _comp( comp ) {}
+
+					bool operator()( const value_type& x, const K& k ) const {
+						return _comp( x.first, k );
+					}
+
+					bool operator()( const K& k, const value_type& x ) const {
+						return _comp( k, x.first );
+					}
+
+				private:
+
+					key_compare _comp;
+
+			};
+
+			// the first value with key k
+			template <class K>
+			tree_node< value_type >* find_node( const K& k ) const {
+				tree_node< value_type >* node = lower_node( k );
+				if ( node && _kcomparer( k, node->value.first ) )
+					return NULL;
+				return node;
+			}
+
+			template <class K>
+			tree_node< value_type >* lower_node( const K& k ) const {
+				return _tree.lower_search( _tree.getRoot(), k, key_value_comp<K>( _kcomparer ) );
+			}
+
+			template <class K>
+			tree_node< value_type >* upper_node( const K& k ) const {
+				return _tree.upper_search( _tree.getRoot(), k, key_value_comp<K>( _kcomparer ) );
+			}
+
+			// both bounds of the values equal to k
+			template <class K>
+			void equal_nodes( const K& k, tree_node< value_type >** lower, tree_node< value_type >** upper ) const {
+				_tree.equal_search( _tree.getRoot(), k, key_value_comp<K>( _kcomparer ), lower, upper );
+			}
+
+			template <class K>
+			size_type count_values( const K& k ) const {
+				tree_node< value_type >* lower;
+				tree_node< value_type >* upper;
+				equal_nodes( k, &lower, &upper );
+				return _tree.distance( to_iterator( lower ).getNode(), to_iterator( upper ).getNode() );
+			}
+
+			iterator to_iterator( tree_node< value_type >* node ) {
+				return node ? iterator( node ) : end();
+			}
+
+			const_iterator to_iterator( tree_node< value_type >* node ) const {
+				return node ? const_iterator( node ) : end();
+			}
+			
+			void printBT( void ) {
+				_tree.printBT( "", _tree.getRoot(), false );
+			}
+
+			class value_comp : std::binary_function< value_type, value_type, bool > {
+
+				friend class multimap;
+
+			protected:
+
+				key_compare comp;
+				value_comp( key_compare c ) : comp( c ) {}
+
+			public:
+				value_comp( void ) {}
+
+				typedef bool 				result_type;
+				typedef value_type			first_argument_type;
+				typedef value_type			second_argument_type;
+				bool operator()( const value_type& x, const value_type& y ) const {
+					return comp( x.first, y.first );
+				}
+				
+				value_comp& operator=( const value_comp& rhs ) {
+					comp = rhs.comp;
+					return *this;
+				}
+
+			};
+
+	};
+
+}
+
+#endif
\ No newline at end of file
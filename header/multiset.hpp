@@ -0,0 +1,366 @@
+#ifndef MULTISET_HPP
+#define MULTISET_HPP
+
+#include "tree.hpp"
+
+namespace ft {
+
+	/*
+	** ft::set allowing equal values, on the same tree: equal values stay
+	** in insertion order, each new one going after the others unless a
+	** hint puts it elsewhere in its run.
+	*/
+	template < class T, class Compare = std::less<T>, class Alloc = std::allocator<T>, class Nodes = plain_nodes >
+	class multiset {
+
+		public:
+
+			/************************************* Typedefs ******************************************/
+
+			typedef T																					key_type;
+			typedef T																					value_type;
+			typedef Compare																				key_compare;
+			typedef Compare																				value_compare;
+			typedef Alloc																				allocator_type;
+			typedef typename Nodes::template rebind< value_type >::other									tree_node_type;
+			typedef typename allocator_type::template rebind< tree_node_type >::other					new_alloc;
+			typedef typename allocator_type::reference													reference;
+			typedef typename allocator_type::const_reference											const_reference;
+			typedef typename allocator_type::pointer													pointer;
+			typedef typename allocator_type::const_pointer												const_pointer;
+			typedef tree_iterator< value_type, ft::tree< value_type, value_compare, new_alloc, tree_node_type > >		iterator;
+			typedef const_tree_iterator< value_type, ft::tree< value_type, value_compare, new_alloc, tree_node_type > >	const_iterator;
+			typedef reverse_iterator<iterator>															reverse_iterator;
+			typedef const_reverse_iterator<const_iterator>												const_reverse_iterator;
+			typedef std::ptrdiff_t																		difference_type;
+			typedef size_t																				size_type;
+
+		private:
+
+			key_compare _kcomparer;
+			value_compare _vcomparer;
+			new_alloc _allocator;
+			tree< value_type, value_compare, new_alloc, tree_node_type > _tree;
+
+		public:
+
+			/************************************* Constructors **************************************/
+
+			explicit multiset( const key_compare& comp = key_compare(), const new_alloc& alloc = new_alloc() )
+			: _kcomparer( comp ), _vcomparer( comp ), _allocator( alloc ), _tree( _vcomparer, alloc ) {}
+
+			// sorted input is appended without any search
+			template <class InputIterator>
+			multiset( InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const new_alloc& alloc = new_alloc() )
+			: _kcomparer( comp ), _vcomparer( comp ), _allocator( alloc ), _tree( _vcomparer, alloc ) {
+				insert( first, last );
+			}
+
+			multiset( const multiset& x ) {
+				*this = x;
+			}
+
+			/************************************* Destructor ****************************************/
+
+			~multiset( void ) {}
+
+			/************************************* Operator = ****************************************/
+
+			multiset& operator=( const multiset& x ) {
+				_tree = x._tree;
+				_vcomparer = x._vcomparer;
+				_kcomparer = x._kcomparer;
+				_allocator = x._allocator;
+				return *this;
+			}
+
+			/************************************* Iterators *****************************************/
+
+			iterator begin( void ) {
+				return _tree.begin();
+			}
+
+			const_iterator begin( void ) const {
+				return _tree.begin();
+			}
+
+			iterator end( void ) {
+				return _tree.end();
+			}
+
+			const_iterator end( void ) const {
+				return _tree.end();
+			}
+
+			reverse_iterator rbegin( void ) {
+				return _tree.rbegin();
+			}
+
+			const_reverse_iterator rbegin( void ) const {
+				return _tree.rbegin();
+			}
+
+			reverse_iterator rend( void ) {
+				return _tree.rend();
+			}
+
+			const_reverse_iterator rend( void ) const {
+				return _tree.rend();
+			}
+
+			/************************************* Capacity ******************************************/
+
+			bool empty( void ) const {
+				return ( _tree.getSize() == 0 ) ? true : false;
+			}
+
+			size_type size( void ) const {
+				return _tree.getSize();
+			}
+
+			size_type max_size( void ) const {
+				return _tree.getAllocator().max_size();
+			}
+
+			/************************************* Modifiers *****************************************/
+
+			iterator insert( const value_type& val ) {
+				return iterator( _tree.add_equal( val, false ) );
+			}
+
+			// O(1) amortized when val fits right before position, e.g. at the upper bound of its value
+			iterator insert( iterator position, const value_type& val ) {
+				return iterator( _tree.hint_add_equal( position.getNode(), val ) );
+			}
+
+			template <class InputIterator>
+			void insert( InputIterator first, InputIterator last ) {
+				while ( first != last ) {
+					insert( end(), *first );
+					first++;
+				}
+			}
+
+			void erase( iterator position ) {
+				if ( position == end() )
+					return ;
+				_tree.del( static_cast< tree_node< value_type >* >( position.getNode() ) );
+			}
+
+			// erases every value equal to val
+			size_type erase( const value_type& val ) {
+				pair<iterator,iterator> range = equal_range( val );
+				size_type n = _tree.distance( range.first.getNode(), range.second.getNode() );
+				_tree.del_range( range.first.getNode(), range.second.getNode() );
+				return n;
+			}
+
+			void erase( iterator first, iterator last ) {
+				_tree.del_range( first.getNode(), last.getNode() );
+			}
+
+			void swap( multiset& x ) {
+				_tree.swap( x._tree );
+			}
+
+			void clear( void ) {
+				_tree.clear();
+			}
+
+			/************************************* Observers *****************************************/
+
+			key_compare key_comp( void ) const {
+				return _kcomparer;
+			}
+
+			value_compare value_comp( void ) const {
+				return _vcomparer;
+			}
+
+			/************************************* Operations ****************************************/
+
+			iterator find( const value_type& val ) {
+				return to_iterator( find_node( val ) );
+			}
+
+			const_iterator find( const value_type& val ) const {
+				return to_iterator( find_node( val ) );
+			}
+
+			// O(log n + count), O(log n) with ft::ranked_nodes
+			size_type count( const value_type& val ) const {
+				return count_values( val );
+			}
+
+			iterator lower_bound( const value_type& val ) {
+				return to_iterator( lower_node( val ) );
+			}
+
+			const_iterator lower_bound( const value_type& val ) const {
+				return to_iterator( lower_node( val ) );
+			}
+
+			iterator upper_bound( const value_type& val ) {
+				return to_iterator( upper_node( val ) );
+			}
+
+			const_iterator upper_bound( const value_type& val ) const {
+				return to_iterator( upper_node( val ) );
+			}
+
+			pair<iterator,iterator> equal_range( const value_type& val ) {
+				tree_node< value_type >* lower;
+				tree_node< value_type >* upper;
+				equal_nodes( val, &lower, &upper );
+				return ft::make_pair( to_iterator( lower ), to_iterator( upper ) );
+			}
+
+			pair<const_iterator,const_iterator> equal_range( const value_type& val ) const {
+				tree_node< value_type >* lower;
+				tree_node< value_type >* upper;
+				equal_nodes( val, &lower, &upper );
+				return ft::make_pair( to_iterator( lower ), to_iterator( upper ) );
+			}
+
+			/*
+			** Lookups by any type the comparator can order against key_type,
+			** only available with a transparent comparator such as ft::less<>:
+			** a multiset<std::string, ..., ft::less<> > can be searched with a const
+			** char* without building a std::string.
+			*/
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type find( const K& k ) {
+				return to_iterator( find_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type find( const K& k ) const {
+				return to_iterator( find_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, size_type >::type count( const K& k ) const {
+				return count_values( k );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type lower_bound( const K& k ) {
+				return to_iterator( lower_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type lower_bound( const K& k ) const {
+				return to_iterator( lower_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type upper_bound( const K& k ) {
+				return to_iterator( upper_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type upper_bound( const K& k ) const {
+				return to_iterator( upper_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, pair<iterator,iterator> >::type equal_range( const K& k ) {
+				tree_node< value_type >* lower;
+				tree_node< value_type >* upper;
+				equal_nodes( k, &lower, &upper );
+				return ft::make_pair( to_iterator( lower ), to_iterator( upper ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, pair<const_iterator,const_iterator> >::type equal_range( const K& k ) const {
+				tree_node< value_type >* lower;
+				tree_node< value_type >* upper;
+				equal_nodes( k, &lower, &upper );
+				return ft::make_pair( to_iterator( lower ), to_iterator( upper ) );
+			}
+
+			/************************************* Order statistics **********************************/
+
+			// O(log n) with ft::ranked_nodes, linear otherwise
+
+			iterator nth( size_type n ) {
+				tree_node< value_type >* node = _tree.select( n );
+				if ( node )
+					return iterator( node );
+				return end();
+			}
+
+			const_iterator nth( size_type n ) const {
+				tree_node< value_type >* node = _tree.select( n );
+				if ( node )
+					return const_iterator( node );
+				return end();
+			}
+
+			size_type rank( const value_type& val ) const {
+				return _tree.rank( val, _kcomparer );
+			}
+
+			difference_type distance( const_iterator first, const_iterator last ) const {
+				return _tree.distance( first.getNode(), last.getNode() );
+			}
+
+			/************************************* Allocator *****************************************/
+
+			allocator_type get_allocator( void ) const {
+				return _allocator;
+			}
+
+		private:
+
+			// the first value equal to k, a transparent comparator orders other key types against values itself
+			template <class K>
+			tree_node< value_type >* find_node( const K& k ) const {
+				tree_node< value_type >* node = lower_node( k );
+				if ( node && _kcomparer( k, node->value ) )
+					return NULL;
+				return node;
+			}
+
+			template <class K>
+			tree_node< value_type >* lower_node( const K& k ) const {
+				return _tree.lower_search( _tree.getRoot(), k, _kcomparer );
+			}
+
+			template <class K>
+			tree_node< value_type >* upper_node( const K& k ) const {
+				return _tree.upper_search( _tree.getRoot(), k, _kcomparer );
+			}
+
+			// both bounds of the values equal to k
+			template <class K>
+			void equal_nodes( const K& k, tree_node< value_type >** lower, tree_node< value_type >** upper ) const {
+				_tree.equal_search( _tree.getRoot(), k, _kcomparer, lower, upper );
+			}
+
+			template <class K>
+			size_type count_values( const K& k ) const {
+				tree_node< value_type >* lower;
+				tree_node< value_type >* upper;
+				equal_nodes( k, &lower, &upper );
+				return _tree.distance( to_iterator( lower ).getNode(), to_iterator( upper ).getNode() );
+			}
+
+			iterator to_iterator( tree_node< value_type >* node ) {
+				return node ? iterator( node ) : end();
+			}
+
+			const_iterator to_iterator( tree_node< value_type >* node ) const {
+				return node ? const_iterator( node ) : end();
+			}
+			
+			void printBT( void ) {
+				_tree.printBT2( "", _tree.getRoot(), false );
+			}
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,278 @@
+#ifndef PERSISTENT_MAP_HPP
+#define PERSISTENT_MAP_HPP
+
+#include <stdexcept>
+#include "persistent_tree.hpp"
+#include "tree.hpp"
+
+namespace ft {
+
+	/*
+	** Ordered map whose copies are O(1) snapshots: they share every node, and
+	** an insert or erase copies only the nodes on its path, O(log n) of them.
+	** Values are read-only through iterators since other versions may see
+	** them. A snapshot stays valid and can be iterated from another thread,
+	** without locks, while the map it was taken from keeps changing; one map
+	** object is not synchronized though. Changing a map invalidates its own
+	** iterators, not those of its snapshots.
+	*/
+	template < class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator< pair< const Key, T > > >
+	class persistent_map {
+
+		private:
+
+			class value_comp;
+
+		public:
+
+			/************************************* Typedefs ******************************************/
+
+			typedef Key																					key_type;
+			typedef T																					mapped_type;
+			typedef Compare																				key_compare;
+			typedef value_comp																			value_compare;
+			typedef pair< key_type, mapped_type >														value_type;
+			typedef Alloc																				allocator_type;
+			typedef typename allocator_type::reference													reference;
+			typedef typename allocator_type::const_reference											const_reference;
+			typedef typename allocator_type::pointer													pointer;
+			typedef typename allocator_type::const_pointer												const_pointer;
+			typedef persistent_tree< value_type, value_compare, allocator_type >						tree_type;
+			typedef typename tree_type::const_iterator													const_iterator;
+			typedef const_iterator																		iterator;
+			typedef typename tree_type::const_reverse_iterator											const_reverse_iterator;
+			typedef const_reverse_iterator																reverse_iterator;
+			typedef std::ptrdiff_t																		difference_type;
+			typedef size_t																				size_type;
+
+		private:
+
+			key_compare _kcomparer;
+			value_compare _vcomparer;
+			allocator_type _allocator;
+			tree_type _tree;
+
+		public:
+
+			/************************************* Constructors **************************************/
+
+			explicit persistent_map( const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type() )
+			: _kcomparer( comp ), _vcomparer( comp ), _allocator( alloc ), _tree( _vcomparer, alloc ) {}
+
+			template <class InputIterator>
+			persistent_map( InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type() )
+			: _kcomparer( comp ), _vcomparer( comp ), _allocator( alloc ), _tree( _vcomparer, alloc ) {
+				insert( first, last );
+			}
+
+			// O(1), the copy shares the nodes of x
+			persistent_map( const persistent_map& x )
+			: _kcomparer( x._kcomparer ), _vcomparer( x._vcomparer ), _allocator( x._allocator ), _tree( x._tree ) {}
+
+			/************************************* Destructor ****************************************/
+
+			~persistent_map( void ) {}
+
+			/************************************* Operator = ****************************************/
+
+			persistent_map& operator=( const persistent_map& x ) {
+				_tree = x._tree;
+				_vcomparer = x._vcomparer;
+				_kcomparer = x._kcomparer;
+				_allocator = x._allocator;
+				return *this;
+			}
+
+			// the current version, frozen: same as a copy
+			persistent_map snapshot( void ) const {
+				return *this;
+			}
+
+			/************************************* Iterators *****************************************/
+
+			const_iterator begin( void ) const {
+				return _tree.begin();
+			}
+
+			const_iterator end( void ) const {
+				return _tree.end();
+			}
+
+			const_reverse_iterator rbegin( void ) const {
+				return _tree.rbegin();
+			}
+
+			const_reverse_iterator rend( void ) const {
+				return _tree.rend();
+			}
+
+			/************************************* Capacity ******************************************/
+
+			bool empty( void ) const {
+				return ( _tree.getSize() == 0 ) ? true : false;
+			}
+
+			size_type size( void ) const {
+				return _tree.getSize();
+			}
+
+			size_type max_size( void ) const {
+				return _tree.getAllocator().max_size();
+			}
+
+			/************************************* Element access ************************************/
+
+			const mapped_type& at( const key_type& k ) const {
+				const_iterator it = find( k );
+				if ( it == end() )
+					throw std::out_of_range( "persistent_map::at" );
+				return it->second;
+			}
+
+			/************************************* Modifiers *****************************************/
+
+			// looks the key up first: an insert that finds it copies no node
+			pair<iterator, bool> insert( const value_type& val ) {
+				iterator it = find( val.first );
+				if ( it != end() )
+					return ft::make_pair( it, false );
+				_tree.add( val, false, &it );
+				return ft::make_pair( it, true );
+			}
+
+			template <class InputIterator>
+			void insert( InputIterator first, InputIterator last ) {
+				while ( first != last ) {
+					insert( *first );
+					first++;
+				}
+			}
+
+			// copies the path to k even when its value was there: the node changes
+			template <class M>
+			pair<iterator, bool> insert_or_assign( const key_type& k, const M& obj ) {
+				iterator it;
+				bool inserted = _tree.add( value_type( k, obj ), true, &it );
+				return ft::make_pair( it, inserted );
+			}
+
+			void erase( iterator position ) {
+				if ( position == end() )
+					return ;
+				_tree.del( position->first, key_value_comp( _kcomparer ) );
+			}
+
+			size_type erase( const key_type& k ) {
+				return _tree.del( k, key_value_comp( _kcomparer ) );
+			}
+
+			void swap( persistent_map& x ) {
+				key_compare k = _kcomparer;
+				_kcomparer = x._kcomparer;
+				x._kcomparer = k;
+				value_compare v = _vcomparer;
+				_vcomparer = x._vcomparer;
+				x._vcomparer = v;
+				allocator_type a = _allocator;
+				_allocator = x._allocator;
+				x._allocator = a;
+				_tree.swap( x._tree );
+			}
+
+			// only drops this version's references, the snapshots keep their nodes
+			void clear( void ) {
+				_tree.clear();
+			}
+
+			/************************************* Observers *****************************************/
+
+			key_compare key_comp( void ) const {
+				return _kcomparer;
+			}
+
+			value_compare value_comp( void ) const {
+				return _vcomparer;
+			}
+
+			/************************************* Operations ****************************************/
+
+			const_iterator find( const key_type& k ) const {
+				return _tree.search( k, key_value_comp( _kcomparer ) );
+			}
+
+			size_type count( const key_type& k ) const {
+				return find( k ) != end() ? 1 : 0;
+			}
+
+			const_iterator lower_bound( const key_type& k ) const {
+				return _tree.lower_search( k, key_value_comp( _kcomparer ) );
+			}
+
+			const_iterator upper_bound( const key_type& k ) const {
+				return _tree.upper_search( k, key_value_comp( _kcomparer ) );
+			}
+
+			pair<const_iterator,const_iterator> equal_range( const key_type& k ) const {
+				return ft::make_pair( lower_bound( k ), upper_bound( k ) );
+			}
+
+			/************************************* Allocator *****************************************/
+
+			allocator_type get_allocator( void ) const {
+				return _allocator;
+			}
+
+		private:
+
+			// orders a key against the key of a value
+			class key_value_comp {
+
+				public:
+
+					key_value_comp( const key_compare& comp ) : _comp( comp ) {}
+
+					bool operator()( const value_type& x, const key_type& k ) const {
+						return _comp( x.first, k );
+					}
+
+					bool operator()( const key_type& k, const value_type& x ) const {
+						return _comp( k, x.first );
+					}
+
+				private:
+
+					key_compare _comp;
+
+			};
+
+			class value_comp : std::binary_function< value_type, value_type, bool > {
+
+				friend class persistent_map;
+
+			protected:
+
+				key_compare comp;
+				value_comp( key_compare c ) : comp( c ) {}
+
+			public:
+				value_comp( void ) {}
+
+				typedef bool 				result_type;
+				typedef value_type			first_argument_type;
+				typedef value_type			second_argument_type;
+				bool operator()( const value_type& x, const value_type& y ) const {
+					return comp( x.first, y.first );
+				}
+
+				value_comp& operator=( const value_comp& rhs ) {
+					comp = rhs.comp;
+					return *this;
+				}
+
+			};
+
+	};
+
+}
+
+#endif
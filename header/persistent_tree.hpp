@@ -0,0 +1,585 @@
+#ifndef PERSISTENT_TREE_HPP
+#define PERSISTENT_TREE_HPP
+
+#include <functional>
+#include <memory>
+#include "iterator.hpp"
+#include "pool_allocator.hpp"
+
+namespace ft {
+
+	/*
+	** Node shared between the versions of a persistent tree. A node can have
+	** several parents, one per version, so it keeps no parent link but counts
+	** the trees and nodes that point to it. The count only changes through
+	** atomic builtins: versions sharing nodes may be copied and destroyed in
+	** different threads.
+	*/
+	template <class T>
+	struct persistent_node {
+
+		persistent_node*	left;
+		persistent_node*	right;
+		size_t				refs;
+		bool				black;
+		T					value;
+
+		persistent_node( const T& val ) : left( NULL ), right( NULL ), refs( 1 ), black( false ), value( val ) {}
+
+	};
+
+	inline void persistent_acquire( size_t* refs ) {
+		__atomic_add_fetch( refs, 1, __ATOMIC_RELAXED );
+	}
+
+	// true when the last reference is gone
+	inline bool persistent_release( size_t* refs ) {
+		return __atomic_sub_fetch( refs, 1, __ATOMIC_ACQ_REL ) == 0;
+	}
+
+	inline bool persistent_unique( const size_t* refs ) {
+		return __atomic_load_n( refs, __ATOMIC_ACQUIRE ) == 1;
+	}
+
+	/*
+	** Without parent links the iterator keeps the path from the root to its
+	** node; an empty path is end(). Only the used part of the path is copied.
+	*/
+	template < class T, class Container >
+	class persistent_iterator {
+
+		public:
+
+			typedef ft::bidirectional_iterator_tag					iterator_category;
+			typedef std::ptrdiff_t									difference_type;
+			typedef T												value_type;
+			typedef T const *										pointer;
+			typedef T const &										reference;
+			typedef T const *										const_pointer;
+			typedef T const &										const_reference;
+			typedef Container const									container_type;
+			typedef container_type *								container_pointer;
+			typedef persistent_node< T >							node_type;
+
+			// a red-black tree of n nodes is at most 2 * log2( n + 1 ) high
+			static const size_t max_height = 2 * sizeof( size_t ) * 8;
+
+			/************************* Constructors and Destructor ***************************/
+
+			persistent_iterator( void ) : _root( NULL ), _depth( 0 ) {}
+			explicit persistent_iterator( const node_type* root ) : _root( root ), _depth( 0 ) {}
+			persistent_iterator( persistent_iterator const & cpy ) {
+				*this = cpy;
+			}
+			~persistent_iterator( void ) {}
+
+			/************************* Member Functions **************************************/
+
+			const node_type* getNode( void ) const {
+				return _depth ? _path[_depth - 1] : NULL;
+			}
+
+			size_t getDepth( void ) const {
+				return _depth;
+			}
+
+			// goes back up to the ancestor at depth
+			void setDepth( size_t depth ) {
+				_depth = depth;
+			}
+
+			void push( const node_type* node ) {
+				_path[_depth++] = node;
+			}
+
+			/************************* Implement operators ***********************************/
+
+			persistent_iterator& operator=( persistent_iterator const & rhs ) {
+				_root = rhs._root;
+				_depth = rhs._depth;
+				for ( size_t i = 0; i < _depth; i++ )
+					_path[i] = rhs._path[i];
+				return *this;
+			}
+
+			const_reference operator*( void ) const {
+				return _path[_depth - 1]->value;
+			}
+
+			const_pointer operator->( void ) const {
+				return &_path[_depth - 1]->value;
+			}
+
+			// end() wraps around to the first node
+			persistent_iterator& operator++( void ) {
+				if ( _depth == 0 ) {
+					push_left( _root );
+					return *this;
+				}
+				if ( _path[_depth - 1]->right ) {
+					push_left( _path[_depth - 1]->right );
+					return *this;
+				}
+				const node_type* child;
+				do {
+					child = _path[--_depth];
+				} while ( _depth && _path[_depth - 1]->right == child );
+				return *this;
+			}
+
+			persistent_iterator operator++( int ) {
+				persistent_iterator tmp = *this;
+				++( *this );
+				return tmp;
+			}
+
+			// the first node goes back to end()
+			persistent_iterator& operator--( void ) {
+				if ( _depth == 0 ) {
+					push_right( _root );
+					return *this;
+				}
+				if ( _path[_depth - 1]->left ) {
+					push_right( _path[_depth - 1]->left );
+					return *this;
+				}
+				const node_type* child;
+				do {
+					child = _path[--_depth];
+				} while ( _depth && _path[_depth - 1]->left == child );
+				return *this;
+			}
+
+			persistent_iterator operator--( int ) {
+				persistent_iterator tmp = *this;
+				--( *this );
+				return tmp;
+			}
+
+		private:
+
+			const node_type* _root;
+			const node_type* _path[max_height];
+			size_t _depth;
+
+			void push_left( const node_type* node ) {
+				for ( ; node; node = node->left )
+					_path[_depth++] = node;
+			}
+
+			void push_right( const node_type* node ) {
+				for ( ; node; node = node->right )
+					_path[_depth++] = node;
+			}
+
+	};
+
+	template <class T, class Container>
+	bool operator==( persistent_iterator<T, Container> const & lhs, persistent_iterator<T, Container> const & rhs ) {
+		return lhs.getNode() == rhs.getNode();
+	}
+	template <class T, class Container>
+	bool operator!=( persistent_iterator<T, Container> const & lhs, persistent_iterator<T, Container> const & rhs ) {
+		return lhs.getNode() != rhs.getNode();
+	}
+
+	/*
+	** Left-leaning red-black tree whose versions share nodes. Copying a tree
+	** only shares its root. Before a node is changed it is made unique: a
+	** node pointed to more than once is first copied for this version, so
+	** an insert or erase copies the O(log n) nodes it walks through and the
+	** siblings its rotations and color flips touch, never the rest.
+	*/
+	template < class T, class Compare, class Alloc >
+	class persistent_tree {
+
+		public:
+
+			typedef persistent_node< T >												node_type;
+			typedef persistent_iterator< T, persistent_tree >							const_iterator;
+			typedef ft::const_reverse_iterator< const_iterator >						const_reverse_iterator;
+			typedef typename Alloc::template rebind< node_type >::other					node_alloc;
+
+			/************************************* Constructors **************************************/
+
+			persistent_tree( const Compare& comp, const Alloc& alloc )
+			: _root( NULL ), _size( 0 ), _comparer( comp ), _allocator( alloc ) {}
+
+			// O(1): both trees share every node
+			persistent_tree( const persistent_tree& x )
+			: _root( x._root ), _size( x._size ), _comparer( x._comparer ), _allocator( x._allocator ) {
+				if ( _root )
+					persistent_acquire( &_root->refs );
+			}
+
+			/************************************* Destructor ****************************************/
+
+			~persistent_tree( void ) {
+				release( _root );
+			}
+
+			/************************************* Operator = ****************************************/
+
+			persistent_tree& operator=( const persistent_tree& x ) {
+				if ( x._root )
+					persistent_acquire( &x._root->refs );
+				release( _root );
+				_root = x._root;
+				_size = x._size;
+				_comparer = x._comparer;
+				_allocator = x._allocator;
+				return *this;
+			}
+
+			/************************************* Iterators *****************************************/
+
+			const_iterator begin( void ) const {
+				return ++end();
+			}
+
+			const_iterator end( void ) const {
+				return const_iterator( _root );
+			}
+
+			const_reverse_iterator rbegin( void ) const {
+				return const_reverse_iterator( --end() );
+			}
+
+			const_reverse_iterator rend( void ) const {
+				return const_reverse_iterator( end() );
+			}
+
+			/************************************* Getters *******************************************/
+
+			const node_type* getRoot( void ) const {
+				return _root;
+			}
+
+			size_t getSize( void ) const {
+				return _size;
+			}
+
+			node_alloc getAllocator( void ) const {
+				return _allocator;
+			}
+
+			/************************************* Lookups *******************************************/
+
+			template <class K, class Comp>
+			const_iterator search( const K& key, Comp comp ) const {
+				const_iterator it( _root );
+				for ( const node_type* node = _root; node; ) {
+					it.push( node );
+					if ( comp( key, node->value ) )
+						node = node->left;
+					else if ( comp( node->value, key ) )
+						node = node->right;
+					else
+						return it;
+				}
+				return end();
+			}
+
+			// first value not ordered before key
+			template <class K, class Comp>
+			const_iterator lower_search( const K& key, Comp comp ) const {
+				const_iterator it( _root );
+				size_t found = 0;
+				for ( const node_type* node = _root; node; ) {
+					it.push( node );
+					if ( comp( node->value, key ) )
+						node = node->right;
+					else {
+						found = it.getDepth();
+						node = node->left;
+					}
+				}
+				it.setDepth( found );
+				return it;
+			}
+
+			// first value ordered after key
+			template <class K, class Comp>
+			const_iterator upper_search( const K& key, Comp comp ) const {
+				const_iterator it( _root );
+				size_t found = 0;
+				for ( const node_type* node = _root; node; ) {
+					it.push( node );
+					if ( comp( key, node->value ) ) {
+						found = it.getDepth();
+						node = node->left;
+					}
+					else
+						node = node->right;
+				}
+				it.setDepth( found );
+				return it;
+			}
+
+			/************************************* Modifiers *****************************************/
+
+			/*
+			** true if val was new, otherwise the value with its key is replaced
+			** when assign is set. position is set to the value either way, from
+			** the path the descent recorded, without another search.
+			*/
+			bool add( const T& val, bool assign, const_iterator* position ) {
+				bool inserted = false;
+				add_path path;
+				path.depth = 0;
+				_root = add( _root, val, assign, &inserted, &path );
+				_root->black = true;
+				*position = const_iterator( _root );
+				while ( path.depth > 0 )
+					position->push( path.nodes[--path.depth] );
+				return inserted;
+			}
+
+			// returns how many values were erased
+			template <class K, class Comp>
+			size_t del( const K& key, Comp comp ) {
+				if ( search( key, comp ) == end() )
+					return 0;
+				_root = own( _root );
+				if ( !is_red( _root->left ) && !is_red( _root->right ) )
+					_root->black = false;
+				_root = del( _root, key, comp );
+				if ( _root )
+					_root->black = true;
+				return 1;
+			}
+
+			void clear( void ) {
+				release( _root );
+				_root = NULL;
+				_size = 0;
+			}
+
+			void swap( persistent_tree& x ) {
+				node_type* root = _root;
+				_root = x._root;
+				x._root = root;
+				size_t size = _size;
+				_size = x._size;
+				x._size = size;
+				Compare comparer = _comparer;
+				_comparer = x._comparer;
+				x._comparer = comparer;
+				node_alloc allocator = _allocator;
+				_allocator = x._allocator;
+				x._allocator = allocator;
+			}
+
+		private:
+
+			/*
+			** The nodes from the root of a subtree down to the value add went
+			** to, stored bottom up so that each level of the recursion pushes
+			** its node on top. Only the top moves when the root is rotated.
+			*/
+			struct add_path {
+
+				const node_type*	nodes[const_iterator::max_height];
+				size_t				depth;
+
+				// top is the new root, the old one is its child now
+				void rotated( const node_type* top ) {
+					const node_type* old = nodes[depth - 1];
+					if ( depth < 2 || nodes[depth - 2] != top ) {
+						nodes[depth++] = top;
+						return ;
+					}
+					const node_type* below = depth > 2 ? nodes[depth - 3] : NULL;
+					if ( below && ( below == old->left || below == old->right ) ) {
+						nodes[depth - 2] = old;
+						nodes[depth - 1] = top;
+					}
+					else
+						depth--;
+				}
+
+			};
+
+			node_type* _root;
+			size_t _size;
+			Compare _comparer;
+			node_alloc _allocator;
+
+			static bool is_red( const node_type* node ) {
+				return node && !node->black;
+			}
+
+			// node is owned by this tree from now on
+			node_type* add( node_type* node, const T& val, bool assign, bool* inserted, add_path* path ) {
+				if ( node == NULL ) {
+					*inserted = true;
+					_size++;
+					node = create_node( val );
+					path->nodes[path->depth++] = node;
+					return node;
+				}
+				node = own( node );
+				if ( _comparer( val, node->value ) )
+					node->left = add( node->left, val, assign, inserted, path );
+				else if ( _comparer( node->value, val ) )
+					node->right = add( node->right, val, assign, inserted, path );
+				else if ( assign )
+					node->value = val;
+				path->nodes[path->depth++] = node;
+				return fix_up( node, path );
+			}
+
+			/*
+			** node is owned and key is in its subtree. On the way down the
+			** node to go to is made red, or gets a red child, so that the
+			** node finally removed is never a black leaf.
+			*/
+			template <class K, class Comp>
+			node_type* del( node_type* node, const K& key, Comp comp ) {
+				if ( comp( key, node->value ) ) {
+					if ( !is_red( node->left ) && !is_red( node->left->left ) )
+						node = move_red_left( node );
+					node->left = del( own( node->left ), key, comp );
+					return fix_up( node );
+				}
+				if ( is_red( node->left ) )
+					node = rotate_right( node );
+				if ( !comp( node->value, key ) && node->right == NULL ) {
+					free_node( node );
+					_size--;
+					return NULL;
+				}
+				if ( !is_red( node->right ) && !is_red( node->right->left ) )
+					node = move_red_right( node );
+				if ( comp( node->value, key ) ) {
+					node->right = del( own( node->right ), key, comp );
+					return fix_up( node );
+				}
+				// the smallest node on the right takes the place of node
+				node_type* next;
+				node_type* right = del_min( own( node->right ), &next );
+				next->left = node->left;
+				next->right = right;
+				next->black = node->black;
+				free_node( node );
+				_size--;
+				return fix_up( next );
+			}
+
+			// unlinks the smallest node of the owned subtree node into *min, without freeing it
+			node_type* del_min( node_type* node, node_type** min ) {
+				if ( node->left == NULL ) {
+					*min = node;
+					return NULL;
+				}
+				if ( !is_red( node->left ) && !is_red( node->left->left ) )
+					node = move_red_left( node );
+				node->left = del_min( own( node->left ), min );
+				return fix_up( node );
+			}
+
+			// path, when given, is kept pointing at the same value
+			node_type* fix_up( node_type* node, add_path* path = NULL ) {
+				if ( is_red( node->right ) && !is_red( node->left ) ) {
+					node = rotate_left( node );
+					if ( path )
+						path->rotated( node );
+				}
+				if ( is_red( node->left ) && is_red( node->left->left ) ) {
+					node = rotate_right( node );
+					if ( path )
+						path->rotated( node );
+				}
+				if ( is_red( node->left ) && is_red( node->right ) )
+					flip_colors( node );
+				return node;
+			}
+
+			node_type* move_red_left( node_type* node ) {
+				flip_colors( node );
+				if ( is_red( node->right->left ) ) {
+					node->right = rotate_right( node->right );
+					node = rotate_left( node );
+					flip_colors( node );
+				}
+				return node;
+			}
+
+			node_type* move_red_right( node_type* node ) {
+				flip_colors( node );
+				if ( is_red( node->left->left ) ) {
+					node = rotate_right( node );
+					flip_colors( node );
+				}
+				return node;
+			}
+
+			// the rotations and the flip take an owned node and own the children they change
+
+			node_type* rotate_left( node_type* node ) {
+				node_type* right = own( node->right );
+				node->right = right->left;
+				right->left = node;
+				right->black = node->black;
+				node->black = false;
+				return right;
+			}
+
+			node_type* rotate_right( node_type* node ) {
+				node_type* left = own( node->left );
+				node->left = left->right;
+				left->right = node;
+				left->black = node->black;
+				node->black = false;
+				return left;
+			}
+
+			void flip_colors( node_type* node ) {
+				node->left = own( node->left );
+				node->right = own( node->right );
+				node->black = !node->black;
+				node->left->black = !node->left->black;
+				node->right->black = !node->right->black;
+			}
+
+			// a node shared with another version is replaced by a copy of it
+			node_type* own( node_type* node ) {
+				if ( node == NULL || persistent_unique( &node->refs ) )
+					return node;
+				node_type* copy = create_node( node->value );
+				copy->black = node->black;
+				copy->left = node->left;
+				copy->right = node->right;
+				if ( copy->left )
+					persistent_acquire( &copy->left->refs );
+				if ( copy->right )
+					persistent_acquire( &copy->right->refs );
+				release( node );
+				return copy;
+			}
+
+			void release( node_type* node ) {
+				while ( node && persistent_release( &node->refs ) ) {
+					release( node->left );
+					node_type* right = node->right;
+					free_node( node );
+					node = right;
+				}
+			}
+
+			node_type* create_node( const T& val ) {
+				node_type* node = _allocator.allocate( 1 );
+				_allocator.construct( node, node_type( val ) );
+				return node;
+			}
+
+			void free_node( node_type* node ) {
+				_allocator.destroy( node );
+				_allocator.deallocate( node, 1 );
+			}
+
+	};
+
+}
+
+#endif
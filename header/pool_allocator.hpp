@@ -0,0 +1,202 @@
+#ifndef POOL_ALLOCATOR_HPP
+#define POOL_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+namespace ft {
+
+	/*
+	** Node allocator for the tree based containers. Single objects are carved
+	** out of large blocks and recycled through an intrusive free list, the
+	** blocks themselves are only given back by release() or when the last copy
+	** of the allocator goes away. Copies share the same pool, an allocator
+	** rebound to another type starts its own. Not thread safe.
+	*/
+	template <class T>
+	class pool_allocator {
+
+		public:
+
+			/************************************* Typedefs ******************************************/
+
+			typedef T						value_type;
+			typedef T*						pointer;
+			typedef const T*				const_pointer;
+			typedef T&						reference;
+			typedef const T&				const_reference;
+			typedef size_t					size_type;
+			typedef std::ptrdiff_t			difference_type;
+
+			template <class U>
+			struct rebind {
+				typedef pool_allocator<U>	other;
+			};
+
+			/************************************* Constructors **************************************/
+
+			pool_allocator( void ) : _pool( new pool() ) {}
+
+			pool_allocator( const pool_allocator& x ) : _pool( x._pool ) {
+				_pool->refs++;
+			}
+
+			template <class U>
+			pool_allocator( const pool_allocator<U>& ) : _pool( new pool() ) {}
+
+			/************************************* Destructor ****************************************/
+
+			~pool_allocator( void ) {
+				drop();
+			}
+
+			/************************************* Operator = ****************************************/
+
+			pool_allocator& operator=( const pool_allocator& x ) {
+				if ( _pool != x._pool ) {
+					x._pool->refs++;
+					drop();
+					_pool = x._pool;
+				}
+				return *this;
+			}
+
+			/************************************* Member functions **********************************/
+
+			pointer address( reference x ) const {
+				return &x;
+			}
+
+			const_pointer address( const_reference x ) const {
+				return &x;
+			}
+
+			pointer allocate( size_type n, const void* = 0 ) {
+				if ( n != 1 )
+					return static_cast<pointer>( ::operator new( n * sizeof( T ) ) );
+				if ( _pool->free_list == NULL )
+					grow();
+				slot* res = _pool->free_list;
+				_pool->free_list = res->next;
+				_pool->live++;
+				return reinterpret_cast<pointer>( res );
+			}
+
+			void deallocate( pointer p, size_type n ) {
+				if ( n != 1 ) {
+					::operator delete( p );
+					return ;
+				}
+				slot* s = reinterpret_cast<slot*>( p );
+				s->next = _pool->free_list;
+				_pool->free_list = s;
+				_pool->live--;
+			}
+
+			// Gives every block back at once, as long as no object is still allocated.
+			void release( void ) {
+				if ( _pool->live == 0 )
+					_pool->clear();
+			}
+
+			size_type max_size( void ) const {
+				return size_type( -1 ) / slot_size;
+			}
+
+			void construct( pointer p, const_reference val ) {
+				new ( static_cast<void*>( p ) ) T( val );
+			}
+
+			void destroy( pointer p ) {
+				p->~T();
+			}
+
+			bool operator==( const pool_allocator& rhs ) const {
+				return _pool == rhs._pool;
+			}
+
+			bool operator!=( const pool_allocator& rhs ) const {
+				return _pool != rhs._pool;
+			}
+
+		private:
+
+			struct slot {
+				slot*	next;
+			};
+
+			union block {
+				block*		next;
+				long double	align;
+			};
+
+			static const size_type slot_size = ( ( sizeof( T ) < sizeof( slot ) ? sizeof( slot ) : sizeof( T ) )
+				+ sizeof( slot ) - 1 ) / sizeof( slot ) * sizeof( slot );
+			static const size_type first_block = 64;
+			static const size_type max_block = 4096;
+
+			struct pool {
+
+				size_type	refs;
+				size_type	live;
+				size_type	next_block;
+				slot*		free_list;
+				block*		blocks;
+
+				pool( void ) : refs( 1 ), live( 0 ), next_block( first_block ), free_list( NULL ), blocks( NULL ) {}
+
+				~pool( void ) {
+					clear();
+				}
+
+				void clear( void ) {
+					while ( blocks ) {
+						block* next = blocks->next;
+						::operator delete( blocks );
+						blocks = next;
+					}
+					free_list = NULL;
+					next_block = first_block;
+				}
+
+			};
+
+			pool* _pool;
+
+			void drop( void ) {
+				if ( --_pool->refs == 0 )
+					delete _pool;
+			}
+
+			void grow( void ) {
+				size_type n = _pool->next_block;
+				block* b = static_cast<block*>( ::operator new( sizeof( block ) + n * slot_size ) );
+				b->next = _pool->blocks;
+				_pool->blocks = b;
+				char* walk = reinterpret_cast<char*>( b + 1 );
+				for ( size_type i = n; i > 0; i-- ) {
+					slot* s = reinterpret_cast<slot*>( walk + ( i - 1 ) * slot_size );
+					s->next = _pool->free_list;
+					_pool->free_list = s;
+				}
+				if ( n < max_block )
+					_pool->next_block = n * 2;
+			}
+
+	};
+
+	/*
+	** Called by tree::clear once all of its nodes are gone. A no-op for
+	** allocators without a pool.
+	*/
+	template <class Alloc>
+	void release_allocator( Alloc& ) {}
+
+	template <class T>
+	void release_allocator( pool_allocator<T>& alloc ) {
+		alloc.release();
+	}
+
+}
+
+#endif
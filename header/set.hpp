@@ -2,11 +2,10 @@
 #define SET_HPP
 
 #include "tree.hpp"
-#include "stack.hpp"
 
 namespace ft {
 
-	template < class T, class Compare = std::less<T>, class Alloc = std::allocator<T> >
+	template < class T, class Compare = std::less<T>, class Alloc = std::allocator<T>, class Nodes = plain_nodes >
 	class set {
 
 		public:
@@ -18,24 +17,30 @@ namespace ft {
 			typedef Compare																				key_compare;
 			typedef Compare																				value_compare;
 			typedef Alloc																				allocator_type;
-			typedef typename allocator_type::template rebind< tree_node< value_type > >::other			new_alloc;
+			typedef typename Nodes::template rebind< value_type >::other									tree_node_type;
+			typedef typename allocator_type::template rebind< tree_node_type >::other					new_alloc;
 			typedef typename allocator_type::reference													reference;
 			typedef typename allocator_type::const_reference											const_reference;
 			typedef typename allocator_type::pointer													pointer;
 			typedef typename allocator_type::const_pointer												const_pointer;
-			typedef tree_iterator< value_type, ft::tree< value_type, value_compare, new_alloc > >		iterator;
-			typedef const_tree_iterator< value_type, ft::tree< value_type, value_compare, new_alloc > >	const_iterator;
+			typedef tree_iterator< value_type, ft::tree< value_type, value_compare, new_alloc, tree_node_type > >		iterator;
+			typedef const_tree_iterator< value_type, ft::tree< value_type, value_compare, new_alloc, tree_node_type > >	const_iterator;
 			typedef reverse_iterator<iterator>															reverse_iterator;
 			typedef const_reverse_iterator<const_iterator>												const_reverse_iterator;
+			typedef tree_node_handle< value_type, new_alloc, tree_node_type >							node_type;
+			typedef typename tree_node_type::aggregate_type												aggregate_type;
 			typedef std::ptrdiff_t																		difference_type;
 			typedef size_t																				size_type;
 
 		private:
 
+			// keys find_batch hands to the tree at a time
+			static const size_type batch_size = 256;
+
 			key_compare _kcomparer;
 			value_compare _vcomparer;
 			new_alloc _allocator;
-			tree< value_type, value_compare, new_alloc > _tree;
+			tree< value_type, value_compare, new_alloc, tree_node_type > _tree;
 
 		public:
 
@@ -77,35 +82,27 @@ namespace ft {
 			}
 
 			iterator end( void ) {
-				if ( _tree.getLast() )
-					return _tree.end();
-				return begin();
+				return _tree.end();
 			}
 
 			const_iterator end( void ) const {
-				if ( _tree.getLast() )
-					return _tree.end();
-				return begin();
+				return _tree.end();
 			}
 
 			reverse_iterator rbegin( void ) {
-				return reverse_iterator( &_tree, _tree.getLast() );
+				return _tree.rbegin();
 			}
 
 			const_reverse_iterator rbegin( void ) const {
-				return const_reverse_iterator( &_tree, _tree.getLast() );
+				return _tree.rbegin();
 			}
 
 			reverse_iterator rend( void ) {
-				if ( _tree.getFirst() )
-					return reverse_iterator( &_tree, _tree.getFirst()->left );
-				return rbegin();
+				return _tree.rend();
 			}
 
 			const_reverse_iterator rend( void ) const {
-				if ( _tree.getFirst() )
-					return const_reverse_iterator( &_tree, _tree.getFirst()->left );
-				return rbegin();
+				return _tree.rend();
 			}
 
 			/************************************* Capacity ******************************************/
@@ -127,45 +124,28 @@ namespace ft {
 			pair<iterator, bool> insert( const value_type& val ) {
 				bool duplicate = false;
 				tree_node< value_type >* res = _tree.add( val, &duplicate );
-				iterator it ( &_tree, res );
+				iterator it ( res );
 				return ft::make_pair<iterator, bool>( it, !duplicate );
 			}
 
+			// O(1) amortized when val goes right before or right after position
 			iterator insert( iterator position, const value_type& val ) {
 				bool duplicate = false;
-				tree_node< value_type > *walk, *node;
-				node = _tree.search( _tree.getRoot(), *position );
-				if ( node == NULL || node == _tree.getRoot() )
-					return insert( val ).first;
-				walk = node->parent;
-				if ( _vcomparer( val, node->value ) ) {
-					if ( !node->isLeft && _vcomparer( val, walk->value ) )
-						return insert( val ).first;
-					else if ( node->isLeft ) 
-						return iterator( &_tree, _tree.hint_add( node, val, &duplicate ) );
-				}
-				else {
-					if ( node->isLeft && _vcomparer( walk->value, val ) )
-						return insert( val ).first;
-					else if ( !node->isLeft )
-						return iterator( &_tree, _tree.hint_add( node, val, &duplicate ) );
-				}
-				return iterator( &_tree, _tree.hint_add( node, val, &duplicate ) );
+				return iterator( _tree.hint_add( position.getNode(), val, &duplicate ) );
 			}
 
 			template <class InputIterator>
 			void insert( InputIterator first, InputIterator last ) {
 				while ( first != last ) {
-					insert( *first );
+					insert( end(), *first );
 					first++;
 				}
 			}
 
 			void erase( iterator position ) {
-				tree_node< value_type > *node = _tree.search( _tree.getRoot(), *position );
-				if ( node == NULL )
+				if ( position == end() )
 					return ;
-				_tree.del( node );
+				_tree.del( static_cast< tree_node< value_type >* >( position.getNode() ) );
 			}
 
 			size_type erase( const value_type& val ) {
@@ -178,15 +158,7 @@ namespace ft {
 			}
 
 			void erase( iterator first, iterator last ) {
-				ft::stack<key_type> a;
-				while ( first != last ) {
-					a.push( *first );
-					first++;
-				}
-				while ( !a.empty() ) {
-					erase( a.top() );
-					a.pop();
-				}
+				_tree.del_range( first.getNode(), last.getNode() );
 			}
 
 			void swap( set& x ) {
@@ -197,6 +169,58 @@ namespace ft {
 				_tree.clear();
 			}
 
+			/************************************* Node handles **************************************/
+
+			// unlinks the element, the iterators to the others stay valid
+			node_type extract( iterator position ) {
+				tree_node< value_type >* node = static_cast< tree_node< value_type >* >( position.getNode() );
+				return node_type( static_cast< tree_node_type* >( _tree.extract( node ) ), _tree.getAllocator() );
+			}
+
+			node_type extract( const key_type& k ) {
+				tree_node< value_type >* node = find_node( k );
+				if ( node == NULL )
+					return node_type();
+				return node_type( static_cast< tree_node_type* >( _tree.extract( node ) ), _tree.getAllocator() );
+			}
+
+			// links the node of nh unless its value is already there, it then stays in nh
+			pair<iterator, bool> insert( const node_type& nh ) {
+				if ( nh.empty() )
+					return ft::make_pair( end(), false );
+				tree_node_base* parent;
+				bool left;
+				tree_node< value_type >* node = _tree.find_slot( nh.value(), _kcomparer, &parent, &left );
+				if ( node )
+					return ft::make_pair( iterator( node ), false );
+				if ( nh.get_allocator() == _tree.getAllocator() )
+					return ft::make_pair( iterator( _tree.link_at( parent, left, nh.release() ) ), true );
+				node = _tree.add_at( parent, left, nh.value() );
+				nh.reset();
+				return ft::make_pair( iterator( node ), true );
+			}
+
+			// moves over the elements of source that are not here yet
+			void merge( set& source ) {
+				_tree.merge( source._tree );
+			}
+
+			/************************************* Set algebra ***************************************/
+
+			// Node reusing set operations, x is left empty.
+
+			void set_union( set& x ) {
+				_tree.set_union( x._tree );
+			}
+
+			void set_intersection( set& x ) {
+				_tree.set_intersection( x._tree );
+			}
+
+			void set_difference( set& x ) {
+				_tree.set_difference( x._tree );
+			}
+
 			/************************************* Observers *****************************************/
 
 			key_compare key_comp( void ) const {
@@ -208,71 +232,179 @@ namespace ft {
 			}
 
 			/************************************* Operations ****************************************/
-			
+
 			iterator find( const value_type& val ) {
-				return iterator( &_tree, _tree.search( _tree.getRoot(), val ) );
+				return to_iterator( find_node( val ) );
 			}
 
 			const_iterator find( const value_type& val ) const {
-				return const_iterator( &_tree, _tree.search( _tree.getRoot(), val ) );
+				return to_iterator( find_node( val ) );
 			}
 
 			size_type count( const value_type& val ) const {
-				if ( _tree.search( _tree.getRoot(), val ) )
-					return 1;
-				return 0;
+				return find_node( val ) ? 1 : 0;
 			}
 
 			iterator lower_bound( const value_type& val ) {
-				tree_node< value_type >* node = _tree.lower_search( _tree.getRoot(), val );
-				if ( node )
-					return iterator( &_tree, node );
-				return end();
+				return to_iterator( lower_node( val ) );
 			}
 
 			const_iterator lower_bound( const value_type& val ) const {
-				tree_node< value_type >* node = _tree.lower_search( _tree.getRoot(), val );
-				if ( node )
-					return const_iterator( &_tree, node );
-				return end();
+				return to_iterator( lower_node( val ) );
 			}
 
 			iterator upper_bound( const value_type& val ) {
-				tree_node< value_type >* node = _tree.lower_search( _tree.getRoot(), val );
-				if ( node ) {
-					if ( !_vcomparer( val, node->value ) && !_vcomparer( node->value, val ) )
-						return ++iterator( &_tree, node );
-					return iterator( &_tree, node );
-				}
-				return end();
+				return to_iterator( upper_node( val ) );
 			}
 
 			const_iterator upper_bound( const value_type& val ) const {
-				tree_node< value_type >* node = _tree.lower_search( _tree.getRoot(), val );
-				if ( node ) {
-					if ( !_vcomparer( val, node->value ) && !_vcomparer( node->value, val ) )
-						return ++const_iterator( &_tree, node );
-					return const_iterator( &_tree, node );
-				}
-				return end();
+				return to_iterator( upper_node( val ) );
 			}
 
 			pair<iterator,iterator> equal_range( const value_type& val ) {
-				tree_node< value_type >* node = _tree.lower_search( _tree.getRoot(), val );
-				if ( node ) {
-					if ( !_vcomparer( val, node->value ) && !_vcomparer( node->value, val ) )
-						return ft::make_pair<iterator,iterator>( iterator( &_tree, node ), ++iterator( &_tree, node ) );
-				}
-				return ft::make_pair<iterator,iterator>( iterator( &_tree, node ), iterator( &_tree, node ) );
+				return ft::make_pair( lower_bound( val ), upper_bound( val ) );
 			}
 
 			pair<const_iterator,const_iterator> equal_range( const value_type& val ) const {
-				tree_node< value_type >* node = _tree.lower_search( _tree.getRoot(), val );
-				if ( node ) {
-					if ( !_vcomparer( val, node->value ) && !_vcomparer( node->value, val ) )
-						return ft::make_pair<const_iterator,const_iterator>( const_iterator( &_tree, node ), ++const_iterator( &_tree, node ) );
+				return ft::make_pair( lower_bound( val ), upper_bound( val ) );
+			}
+
+			/*
+			** find for keys[0] up to keys[n - 1] into out[0] up to out[n - 1].
+			** The descents are interleaved so their cache misses overlap, which
+			** pays off once the tree no longer fits in the cache.
+			*/
+			void find_batch( const value_type* keys, size_type n, iterator* out ) {
+				tree_node< value_type >* nodes[batch_size];
+				for ( size_type i = 0; i < n; i += batch_size ) {
+					size_type m = ( n - i < batch_size ) ? n - i : batch_size;
+					_tree.search_batch( keys + i, m, _kcomparer, nodes );
+					for ( size_type j = 0; j < m; j++ )
+						out[i + j] = to_iterator( nodes[j] );
+				}
+			}
+
+			void find_batch( const value_type* keys, size_type n, const_iterator* out ) const {
+				tree_node< value_type >* nodes[batch_size];
+				for ( size_type i = 0; i < n; i += batch_size ) {
+					size_type m = ( n - i < batch_size ) ? n - i : batch_size;
+					_tree.search_batch( keys + i, m, _kcomparer, nodes );
+					for ( size_type j = 0; j < m; j++ )
+						out[i + j] = to_iterator( nodes[j] );
 				}
-				return ft::make_pair<const_iterator,const_iterator>( const_iterator( &_tree, node ), const_iterator( &_tree, node ) );
+			}
+
+			/*
+			** find for every key of [first, last), which must be sorted, into
+			** out. Each search resumes from where the previous one ended, so a
+			** dense run of m keys costs O(m log(n / m)) instead of O(m log n).
+			*/
+			template <class InputIterator, class OutputIterator>
+			OutputIterator find_sorted( InputIterator first, InputIterator last, OutputIterator out ) {
+				tree_node_base* finger = begin().getNode();
+				for ( ; first != last; ++first, ++out )
+					*out = to_iterator( _tree.finger_search( &finger, value_type( *first ), _kcomparer ) );
+				return out;
+			}
+
+			template <class InputIterator, class OutputIterator>
+			OutputIterator find_sorted( InputIterator first, InputIterator last, OutputIterator out ) const {
+				tree_node_base* finger = begin().getNode();
+				for ( ; first != last; ++first, ++out )
+					*out = to_iterator( _tree.finger_search( &finger, value_type( *first ), _kcomparer ) );
+				return out;
+			}
+
+			/*
+			** Lookups by any type the comparator can order against key_type,
+			** only available with a transparent comparator such as ft::less<>:
+			** a set<std::string, ..., ft::less<> > can be searched with a const
+			** char* without building a std::string.
+			*/
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type find( const K& k ) {
+				return to_iterator( find_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type find( const K& k ) const {
+				return to_iterator( find_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, size_type >::type count( const K& k ) const {
+				return find_node( k ) ? 1 : 0;
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type lower_bound( const K& k ) {
+				return to_iterator( lower_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type lower_bound( const K& k ) const {
+				return to_iterator( lower_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, iterator >::type upper_bound( const K& k ) {
+				return to_iterator( upper_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, const_iterator >::type upper_bound( const K& k ) const {
+				return to_iterator( upper_node( k ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, pair<iterator,iterator> >::type equal_range( const K& k ) {
+				return ft::make_pair( to_iterator( lower_node( k ) ), to_iterator( upper_node( k ) ) );
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent< key_compare, K, pair<const_iterator,const_iterator> >::type equal_range( const K& k ) const {
+				return ft::make_pair( to_iterator( lower_node( k ) ), to_iterator( upper_node( k ) ) );
+			}
+
+			/************************************* Order statistics **********************************/
+
+			// O(log n) with ft::ranked_nodes, linear otherwise
+
+			iterator nth( size_type n ) {
+				tree_node< value_type >* node = _tree.select( n );
+				if ( node )
+					return iterator( node );
+				return end();
+			}
+
+			const_iterator nth( size_type n ) const {
+				tree_node< value_type >* node = _tree.select( n );
+				if ( node )
+					return const_iterator( node );
+				return end();
+			}
+
+			size_type rank( const value_type& val ) const {
+				return _tree.rank( val, _kcomparer );
+			}
+
+			difference_type distance( const_iterator first, const_iterator last ) const {
+				return _tree.distance( first.getNode(), last.getNode() );
+			}
+
+			/************************************* Aggregates ****************************************/
+
+			// only with ft::aggregate_nodes, whose Monoid gives the type and the operations
+
+			// aggregate of the values whose key is in [lo, hi), O(log n)
+			aggregate_type aggregate( const value_type& lo, const value_type& hi ) const {
+				return _tree.aggregate( lo, hi, _kcomparer );
+			}
+
+			// aggregate of every value, O(1)
+			aggregate_type aggregate( void ) const {
+				return _tree.aggregate();
 			}
 
 			/************************************* Allocator *****************************************/
@@ -282,6 +414,30 @@ namespace ft {
 			}
 
 		private:
+
+			// a transparent comparator orders other key types against values itself
+			template <class K>
+			tree_node< value_type >* find_node( const K& k ) const {
+				return _tree.search( _tree.getRoot(), k, _kcomparer );
+			}
+
+			template <class K>
+			tree_node< value_type >* lower_node( const K& k ) const {
+				return _tree.lower_search( _tree.getRoot(), k, _kcomparer );
+			}
+
+			template <class K>
+			tree_node< value_type >* upper_node( const K& k ) const {
+				return _tree.upper_search( _tree.getRoot(), k, _kcomparer );
+			}
+
+			iterator to_iterator( tree_node< value_type >* node ) {
+				return node ? iterator( node ) : end();
+			}
+
+			const_iterator to_iterator( tree_node< value_type >* node ) const {
+				return node ? const_iterator( node ) : end();
+			}
 			
 			void printBT( void ) {
 				_tree.printBT2( "", _tree.getRoot(), false );
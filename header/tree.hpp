@@ -4,24 +4,300 @@
 #include <functional>
 #include <memory>
 #include "iterator.hpp"
+#include "pool_allocator.hpp"
 
 namespace ft {
 
+	// hint that p will be read soon, a no-op where the builtin is missing
+	inline void tree_prefetch( const void* p ) {
+#ifdef __GNUC__
+		__builtin_prefetch( p );
+#else
+		( void )p;
+#endif
+	}
+
+	/*
+	** Links shared by every node. The parent pointer is at least 4 bytes
+	** aligned, its two low bits hold the color and the side of the node.
+	*/
+	struct tree_node_base {
+
+		tree_node_base*	left;
+		tree_node_base*	right;
+
+		tree_node_base( void ) : left( NULL ), right( NULL ), _parent( 0 ) {}
+
+		tree_node_base* getParent( void ) const {
+			return reinterpret_cast<tree_node_base*>( _parent & ~flag_mask );
+		}
+
+		void setParent( tree_node_base* parent ) {
+			_parent = reinterpret_cast<size_t>( parent ) | ( _parent & flag_mask );
+		}
+
+		bool isBlack( void ) const {
+			return ( _parent & black_bit ) != 0;
+		}
+
+		void setBlack( bool black ) {
+			_parent = black ? _parent | black_bit : _parent & ~black_bit;
+		}
+
+		bool isLeft( void ) const {
+			return ( _parent & left_bit ) != 0;
+		}
+
+		void setLeft( bool isLeft ) {
+			_parent = isLeft ? _parent | left_bit : _parent & ~left_bit;
+		}
+
+		private:
+
+			static const size_t black_bit = 1;
+			static const size_t left_bit = 2;
+			static const size_t flag_mask = 3;
+
+			size_t			_parent;
+
+	};
+
+	// left incomplete: only aggregate nodes can sum up a range
+	struct tree_no_aggregate;
+
+	/*
+	** Plain node. A tree can allocate a type derived from it instead to keep
+	** extra data per subtree: update() recomputes that data from the node's
+	** children and is called bottom up wherever the shape changes, as long as
+	** augmented is set. It gets the tree's comparator, for nodes whose data
+	** is ordered by it.
+	*/
 	template <class T>
-	struct tree_node {
+	struct tree_node : tree_node_base {
+
+		static const bool	augmented = false;
+		static const bool	ranked = false;
 
 		T			value;
-		bool		black;
-		bool		isLeft;
-		tree_node*	parent;
-		tree_node*	left;
-		tree_node*	right;
 
-		tree_node( void ) : parent( NULL ), left( NULL ), right( NULL ), black( true ), isLeft( false ) {}
-		tree_node( T val ) : value( val ), black( false ), isLeft( false ), parent( NULL ), left( NULL ), right( NULL ) {}
+		tree_node( const T& val ) : tree_node_base(), value( val ) {}
+
+		template <class Comp>
+		void update( const Comp& ) {}
+
+		static size_t count( const tree_node_base* ) {
+			return 0;
+		}
+
+		typedef tree_no_aggregate	aggregate_type;
+
+	};
+
+	// Keeps the size of its subtree, for order statistics.
+	template <class T>
+	struct ranked_tree_node : tree_node<T> {
+
+		static const bool	augmented = true;
+		static const bool	ranked = true;
+
+		size_t		size;
+
+		ranked_tree_node( const T& val ) : tree_node<T>( val ), size( 1 ) {}
+
+		template <class Comp>
+		void update( const Comp& ) {
+			size = 1 + count( this->left ) + count( this->right );
+		}
+
+		static size_t count( const tree_node_base* node ) {
+			return node ? static_cast< const ranked_tree_node* >( node )->size : 0;
+		}
 
 	};
 
+	/*
+	** Keeps the aggregate of the values of its subtree. Monoid has static
+	** members only: result_type, identity(), lift( value ) and combine( a, b ),
+	** which must be associative but not commutative, values are combined in
+	** order.
+	*/
+	template <class T, class Monoid>
+	struct aggregate_tree_node : tree_node<T> {
+
+		static const bool	augmented = true;
+		static const bool	ranked = false;
+
+		typedef Monoid							monoid_type;
+		typedef typename Monoid::result_type	aggregate_type;
+
+		aggregate_type	total;
+
+		aggregate_tree_node( const T& val ) : tree_node<T>( val ), total( Monoid::lift( val ) ) {}
+
+		template <class Comp>
+		void update( const Comp& ) {
+			total = Monoid::combine( Monoid::combine( sum( this->left ), Monoid::lift( this->value ) ), sum( this->right ) );
+		}
+
+		static aggregate_type sum( const tree_node_base* node ) {
+			return node ? static_cast< const aggregate_tree_node* >( node )->total : Monoid::identity();
+		}
+
+	};
+
+	/*
+	** Node policies, given as the last template parameter of map and set to
+	** choose the node type of their tree.
+	*/
+	struct plain_nodes {
+		template <class V>
+		struct rebind {
+			typedef tree_node<V>		other;
+		};
+	};
+
+	struct ranked_nodes {
+		template <class V>
+		struct rebind {
+			typedef ranked_tree_node<V>	other;
+		};
+	};
+
+	template <class Monoid>
+	struct aggregate_nodes {
+		template <class V>
+		struct rebind {
+			typedef aggregate_tree_node<V, Monoid>	other;
+		};
+	};
+
+	/*
+	** Owns a node taken out of a tree by extract() until insert() links it
+	** into another tree with the same node type, so the value is neither
+	** copied nor reallocated. C++98 has no move: as with std::auto_ptr,
+	** copying a handle takes the node away from the copied one.
+	*/
+	template <class T, class Alloc, class Node>
+	class tree_node_handle {
+
+		public:
+
+			typedef T				value_type;
+			typedef Alloc			allocator_type;
+
+			/************************************* Constructors **************************************/
+
+			tree_node_handle( void ) : _node( NULL ) {}
+
+			tree_node_handle( Node* node, const allocator_type& alloc ) : _node( node ), _allocator( alloc ) {}
+
+			tree_node_handle( const tree_node_handle& x ) : _node( x.release() ), _allocator( x._allocator ) {}
+
+			/************************************* Destructor ****************************************/
+
+			~tree_node_handle( void ) {
+				reset();
+			}
+
+			/************************************* Operator = ****************************************/
+
+			tree_node_handle& operator=( const tree_node_handle& x ) {
+				if ( this != &x ) {
+					reset();
+					_allocator = x._allocator;
+					_node = x.release();
+				}
+				return *this;
+			}
+
+			/************************************* Member functions **********************************/
+
+			bool empty( void ) const {
+				return _node == NULL;
+			}
+
+			value_type& value( void ) const {
+				return _node->value;
+			}
+
+			allocator_type get_allocator( void ) const {
+				return _allocator;
+			}
+
+			Node* getNode( void ) const {
+				return _node;
+			}
+
+			// gives up the node without freeing it
+			Node* release( void ) const {
+				Node* node = _node;
+				_node = NULL;
+				return node;
+			}
+
+			// frees the node, if any
+			void reset( void ) const {
+				if ( _node ) {
+					_allocator.destroy( _node );
+					_allocator.deallocate( _node, 1 );
+					_node = NULL;
+				}
+			}
+
+			void swap( tree_node_handle& x ) {
+				Node* node = _node;
+				_node = x._node;
+				x._node = node;
+				allocator_type a = _allocator;
+				_allocator = x._allocator;
+				x._allocator = a;
+			}
+
+		private:
+
+			mutable Node* _node;
+			mutable allocator_type _allocator;
+
+	};
+
+	/*
+	** The header is the only red node whose parent is NULL (empty tree) or
+	** whose grandparent is itself (its parent is the root, which is black).
+	*/
+	inline bool tree_is_header( const tree_node_base* node ) {
+		return !node->isBlack() && ( node->getParent() == NULL || node->getParent()->getParent() == node );
+	}
+
+	// In-order successor, end() wraps around to begin().
+	inline tree_node_base* tree_increment( tree_node_base* node ) {
+		if ( tree_is_header( node ) )
+			return node->left;
+		if ( node->right ) {
+			node = node->right;
+			while ( node->left )
+				node = node->left;
+			return node;
+		}
+		while ( !node->isLeft() && node->getParent()->getParent() != node )
+			node = node->getParent();
+		return node->getParent();
+	}
+
+	// In-order predecessor, begin() goes back to end().
+	inline tree_node_base* tree_decrement( tree_node_base* node ) {
+		if ( tree_is_header( node ) )
+			return node->right;
+		if ( node->left ) {
+			node = node->left;
+			while ( node->right )
+				node = node->right;
+			return node;
+		}
+		while ( node->isLeft() )
+			node = node->getParent();
+		return node->getParent();
+	}
+
 	template <class T, class Container>
 	class tree_iterator;
 
@@ -34,42 +310,67 @@ namespace ft {
 	template <class ConstIter>
 	class const_reverse_iterator;
 
-	template < class T, class value_comp = std::less<T>, class Alloc = std::allocator< tree_node< T > > >
+	template < class T, class Alloc >
+	class vector;
+
+	template < class T, class value_comp = std::less<T>, class Alloc = std::allocator< tree_node< T > >, class Node = tree_node< T > >
 	class tree {
 
 		private:
 
-			tree_node< T > * _root;
-			tree_node< T > * _first;
-			tree_node< T > * _last;
+			// holds the sorted head of a range until it is built
+			typedef ft::vector< T, typename Alloc::template rebind< T >::other >	value_buffer;
+
+			// ranges up to this length are erased one node at a time
+			static const size_t short_range = 32;
+
+			// descents search_batch keeps in flight
+			static const size_t batch_lanes = 16;
+
+			// parent is the root, left the first and right the last node
+			tree_node_base _header;
 			size_t _size;
 			Alloc _allocator;
 			value_comp _comparer;
 
 		public:
 
-			typedef ft::tree_iterator< T, ft::tree< T, value_comp, Alloc > >	iterator;
-			typedef const_tree_iterator< T, ft::tree< T, value_comp, Alloc > >	const_iterator;
+			typedef ft::tree_iterator< T, ft::tree< T, value_comp, Alloc, Node > >	iterator;
+			typedef const_tree_iterator< T, ft::tree< T, value_comp, Alloc, Node > >	const_iterator;
 			typedef reverse_iterator<iterator>									reverse_iterator;
 			typedef const_reverse_iterator<const_iterator>						const_reverse_iterator;
 
-			tree( void ) : _root( NULL ), _first( NULL ), _last( NULL ), _size( 0 ) {}
+			tree( void ) : _size( 0 ) {
+				reset_header();
+			}
 
-			tree( const value_comp& comp, const Alloc& alloc ) : _root( NULL ), _first( NULL ), _last( NULL ), _size( 0 ) {
+			tree( const value_comp& comp, const Alloc& alloc ) : _size( 0 ) {
+				reset_header();
 				_comparer = comp;
 				_allocator = alloc;
 			}
 
 			template <class InputIterator>
-			tree( InputIterator first, InputIterator last, const value_comp& comp, const Alloc& alloc ) : _root( NULL ), _first( NULL ), _last( NULL ), _size( 0 ) {
+			tree( InputIterator first, InputIterator last, const value_comp& comp, const Alloc& alloc ) : _size( 0 ) {
+				reset_header();
 				_comparer = comp;
 				_allocator = alloc;
-				bool duplicate = false;
-				while ( first != last )
-					add( *first++, &duplicate );
+				{
+					// only the strictly increasing head is buffered, then built in O(n)
+					value_buffer values( _allocator );
+					while ( first != last && ( values.empty() || _comparer( values.back(), *first ) ) )
+						values.push_back( *first++ );
+					build( values );
+				}
+				bool duplicate;
+				for ( ; first != last; ++first ) {
+					duplicate = false;
+					add( *first, &duplicate );
+				}
 			}
 
-			tree( const tree& x ) {
+			tree( const tree& x ) : _size( 0 ) {
+				reset_header();
 				*this = x;
 			}
 
@@ -85,7 +386,7 @@ namespace ft {
 					std::cout << (isLeft ? "├──L:" : "└──R:" );
 
 					// print the value of the node
-					if ( !node->black ) {
+					if ( !node->isBlack() ) {
 						std::cout << "\033[31m[" << node->value.first << " -- ";
 						std::cout << node->value.second << "]\033[0m" << std::endl;
 					}
@@ -95,8 +396,8 @@ namespace ft {
 					}
 
 					// enter the next tree level - left and right branch
-					printBT( prefix + (isLeft ? "│   " : "    "), node->left, true);
-					printBT( prefix + (isLeft ? "│   " : "    "), node->right, false);
+					printBT( prefix + (isLeft ? "│   " : "    "), to_node( node->left ), true);
+					printBT( prefix + (isLeft ? "│   " : "    "), to_node( node->right ), false);
 				}
 			}
 
@@ -107,7 +408,7 @@ namespace ft {
 					std::cout << (isLeft ? "├──L:" : "└──R:" );
 
 					// print the value of the node
-					if ( !node->black ) {
+					if ( !node->isBlack() ) {
 						std::cout << "\033[31m[" << node->value;
 						std::cout << "]\033[0m" << std::endl;
 					}
@@ -117,53 +418,60 @@ namespace ft {
 					}
 
 					// enter the next tree level - left and right branch
-					printBT2( prefix + (isLeft ? "│   " : "    "), node->left, true);
-					printBT2( prefix + (isLeft ? "│   " : "    "), node->right, false);
+					printBT2( prefix + (isLeft ? "│   " : "    "), to_node( node->left ), true);
+					printBT2( prefix + (isLeft ? "│   " : "    "), to_node( node->right ), false);
 				}
 			}
 
 			tree& operator=( const tree& x ) {
-				clear( _root );
-				_root = NULL;
-				_first = NULL;
-				_last = NULL;
+				if ( this == &x )
+					return *this;
+				clear( getRoot() );
+				reset_header();
 				_size = 0;
 				_comparer = x._comparer;
 				_allocator = x._allocator;
-				copy( x._root );
+				if ( x.getRoot() == NULL )
+					return *this;
+				_header.setParent( clone( x.getRoot(), &_header, x ) );
+				_size = x._size;
 				return *this;
 			}
 
 			iterator begin( void ) {
-				return iterator( this, _first );
+				return iterator( _header.left );
 			}
 
 			const_iterator begin( void ) const {
-				return const_iterator( this, _first );
+				return const_iterator( _header.left );
 			}
 
 			iterator end( void ) {
-				if ( _last )
-					return iterator( this, _last->right );
-				return begin();
+				return iterator( &_header );
 			}
 
 			const_iterator end( void ) const {
-				if ( _last )
-					return const_iterator( this, _last->right );
-				return begin();
+				return const_iterator( const_cast< tree_node_base* >( &_header ) );
 			}
 
-			tree_node< T > * getRoot( void ) const {
-				return _root;
+			reverse_iterator rbegin( void ) {
+				return reverse_iterator( _header.right );
+			}
+
+			const_reverse_iterator rbegin( void ) const {
+				return const_reverse_iterator( _header.right );
+			}
+
+			reverse_iterator rend( void ) {
+				return reverse_iterator( &_header );
 			}
 
-			tree_node< T > * getFirst( void ) const {
-				return _first;
+			const_reverse_iterator rend( void ) const {
+				return const_reverse_iterator( const_cast< tree_node_base* >( &_header ) );
 			}
 
-			tree_node< T > * getLast( void ) const {
-				return _last;
+			tree_node< T > * getRoot( void ) const {
+				return to_node( _header.getParent() );
 			}
 
 			size_t getSize( void ) const {
@@ -174,179 +482,1029 @@ namespace ft {
 				return _allocator;
 			}
 
-			tree_node<T>* add( T p, bool *duplicate ) {
-				tree_node< T >* res;
-				tree_node< T >* node = _allocator.allocate( 1 );
-				_allocator.construct( node, tree_node<T>( p ) );
-				if ( _root == NULL ) {
-					_root = node;
-					_root->black = true;
-					_first = _root;
-					_last = _root;
+			// nothing is allocated when p is already there
+			tree_node<T>* add( T const & p, bool *duplicate ) {
+				tree_node_base* parent;
+				bool left;
+				tree_node< T >* res = find_slot( p, _comparer, &parent, &left );
+				if ( res ) {
+					*duplicate = true;
+					return res;
+				}
+				return add_at( parent, left, p );
+			}
+
+			/*
+			** Returns the node equal to key, or NULL and where a node for key
+			** would be linked: the header for an empty tree, otherwise a parent
+			** and a side for add_at.
+			*/
+			template <class K, class Comp>
+			tree_node< T >* find_slot( K const & key, Comp comp, tree_node_base** parent, bool* left ) const {
+				tree_node_base* node = _header.getParent();
+				*parent = const_cast< tree_node_base* >( &_header );
+				*left = true;
+				while ( node ) {
+					*parent = node;
+					if ( comp( key, to_node( node )->value ) ) {
+						*left = true;
+						node = node->left;
+					}
+					else if ( comp( to_node( node )->value, key ) ) {
+						*left = false;
+						node = node->right;
+					}
+					else
+						return to_node( node );
+				}
+				return NULL;
+			}
+
+			tree_node< T >* add_at( tree_node_base* parent, bool left, T const & p ) {
+				return link_at( parent, left, create_node( p ) );
+			}
+
+			// add_at for a node that is already built, such as an extracted one
+			tree_node< T >* link_at( tree_node_base* parent, bool left, tree_node< T >* node ) {
+				update( node );		// its value may have changed since it was extracted
+				if ( parent == &_header ) {
+					node->setBlack( true );
+					set_header( node, node, node );
 					_size++;
 					return node;
 				}
-				res = add( _root, node, duplicate );
-				if ( *duplicate ) {
-					free_node( node );
-					return res;
+				link( parent, node, left );
+				return attach( node );
+			}
+
+			/*
+			** Equal values allowed, for the multi containers: p goes after the
+			** values equal to it, or before them when first is set.
+			*/
+			tree_node< T >* add_equal( T const & p, bool first ) {
+				tree_node_base* parent = &_header;
+				bool left = true;
+				for ( tree_node_base* node = _header.getParent(); node; node = left ? node->left : node->right ) {
+					parent = node;
+					if ( first )
+						left = !_comparer( to_node( node )->value, p );
+					else
+						left = _comparer( p, to_node( node )->value );
 				}
-				check_color( node );
-				if ( _comparer( node->value, _first->value ) )
-					_first = node;
-				if ( _comparer( _last->value, node->value ) )
-					_last = node;
-				_root->black = true;
-				_size++;
-				return node;
+				return add_at( parent, left, p );
 			}
 
-			tree_node<T>* hint_add( tree_node< T >* position, T p, bool *duplicate ) {
-				tree_node< T >* res;
-				tree_node< T >* node = _allocator.allocate( 1 );
-				_allocator.construct( node, tree_node<T>( p ) );
-				res = add( position, node, duplicate );
-				if ( *duplicate ) {
-					free_node( node );
-					return res;
+			/*
+			** Equal values allowed: p goes right before position when the order
+			** allows it, without any search, otherwise as close to position as
+			** the order allows. Inserting at the upper bound of a key, or at
+			** end(), appends to its run of equal values in O(1) amortized.
+			*/
+			tree_node< T >* hint_add_equal( tree_node_base* position, T const & p ) {
+				if ( _size == 0 )
+					return add_at( &_header, true, p );
+				if ( !tree_is_header( position ) && _comparer( to_node( position )->value, p ) )
+					return add_equal( p, true );
+				if ( position != _header.left && _comparer( p, to_node( tree_decrement( position ) )->value ) )
+					return add_equal( p, false );
+				if ( tree_is_header( position ) )
+					return add_at( _header.right, false, p );
+				if ( position->left == NULL )
+					return add_at( position, true, p );
+				return add_at( tree_decrement( position ), false, p );
+			}
+
+			/*
+			** p goes between position and its predecessor when it fits there,
+			** linked to whichever of the two has a free side, without any
+			** search. Right after position works too. Otherwise it is a plain
+			** add. Appending sorted values at end() is O(1) amortized.
+			*/
+			tree_node< T >* hint_add( tree_node_base* position, T const & p, bool *duplicate ) {
+				if ( _size == 0 )
+					return add_at( &_header, true, p );
+				if ( !tree_is_header( position ) && !_comparer( p, to_node( position )->value ) ) {
+					if ( !_comparer( to_node( position )->value, p ) ) {
+						*duplicate = true;
+						return to_node( position );
+					}
+					if ( position == _header.right )
+						return add_at( position, false, p );
+					tree_node_base* next = tree_increment( position );
+					if ( !_comparer( p, to_node( next )->value ) )
+						return add( p, duplicate );
+					if ( position->right == NULL )
+						return add_at( position, false, p );
+					return add_at( next, true, p );
 				}
-				check_color( node );
-				if ( _comparer( node->value, _first->value ) )
-					_first = node;
-				if ( _comparer( _last->value, node->value ) )
-					_last = node;
-				_root->black = true;
-				_size++;
-				return node;
+				if ( position == _header.left )
+					return add_at( position, true, p );
+				tree_node_base* prev = tree_decrement( position );
+				if ( !_comparer( to_node( prev )->value, p ) )
+					return add( p, duplicate );
+				if ( prev->right == NULL )
+					return add_at( prev, false, p );
+				return add_at( position, true, p );
 			}
 
-			tree_node< T >* search( tree_node< T >* node, T const key ) const {
-				if ( node == NULL )
-					return NULL;
-				if ( !_comparer( node->value, key ) && !_comparer( key, node->value ) )
-					return node;
+			iterator find( T const & key ) {
+				tree_node< T >* node = search( getRoot(), key );
+				if ( node )
+					return iterator( node );
+				return end();
+			}
+
+			const_iterator find( T const & key ) const {
+				tree_node< T >* node = search( getRoot(), key );
+				if ( node )
+					return const_iterator( node );
+				return end();
+			}
+
+			tree_node< T >* search( tree_node< T >* node, T const & key ) const {
+				return search( node, key, _comparer );
+			}
+
+			/*
+			** The searches below take the key in any form comp can order against
+			** a value, comp( value, key ) and comp( key, value ) must both work.
+			** The containers use them to look up a key without building a value.
+			*/
+			template <class K, class Comp>
+			tree_node< T >* search( tree_node< T >* node, K const & key, Comp comp ) const {
+				while ( node ) {
+					if ( comp( key, node->value ) )
+						node = to_node( node->left );
+					else if ( comp( node->value, key ) )
+						node = to_node( node->right );
+					else
+						return node;
+				}
+				return NULL;
+			}
+
+			// first node not ordered before key
+			template <class K, class Comp>
+			tree_node< T >* lower_search( tree_node< T >* node, K const & key, Comp comp ) const {
 				tree_node< T >* res = NULL;
-				if ( !( res = search( node->left, key ) ) )
-					res = search( node->right, key );
+				while ( node ) {
+					if ( comp( node->value, key ) )
+						node = to_node( node->right );
+					else {
+						res = node;
+						node = to_node( node->left );
+					}
+				}
 				return res;
 			}
 
-			tree_node< T >* lower_search( tree_node< T >* node, T const key ) const {
+			// first node ordered after key
+			template <class K, class Comp>
+			tree_node< T >* upper_search( tree_node< T >* node, K const & key, Comp comp ) const {
 				tree_node< T >* res = NULL;
 				while ( node ) {
-					if ( !_comparer( node->value, key ) && !_comparer( key, node->value ) )
-						return node;
-					if ( _comparer( node->value, key ) )
+					if ( comp( key, node->value ) ) {
+						res = node;
+						node = to_node( node->left );
+					}
+					else
+						node = to_node( node->right );
+				}
+				return res;
+			}
+
+			// both bounds in one descent: they share the path down to the first node equal to key
+			template <class K, class Comp>
+			void equal_search( tree_node< T >* node, K const & key, Comp comp, tree_node< T >** lower, tree_node< T >** upper ) const {
+				*lower = NULL;
+				*upper = NULL;
+				while ( node ) {
+					if ( comp( node->value, key ) )
+						node = to_node( node->right );
+					else if ( comp( key, node->value ) ) {
+						*lower = node;
+						*upper = node;
+						node = to_node( node->left );
+					}
+					else {
+						tree_node< T >* res = upper_search( to_node( node->right ), key, comp );
+						if ( res )
+							*upper = res;
+						res = lower_search( to_node( node->left ), key, comp );
+						*lower = res ? res : node;
+						return ;
+					}
+				}
+			}
+
+			/*
+			** search for n keys at once, out[i] gets the node equal to keys[i]
+			** or NULL. Up to batch_lanes descents take one step each per round
+			** and prefetch the child they move to, so the cache misses of
+			** different keys overlap instead of queuing behind each other. A
+			** lane that is done starts over from the root with the next key.
+			*/
+			template <class K, class Comp>
+			void search_batch( K const * keys, size_t n, Comp comp, tree_node< T >** out ) const {
+				tree_node_base* root = _header.getParent();
+				tree_node_base* node[batch_lanes];
+				size_t key[batch_lanes];
+				size_t lanes = 0;
+				size_t next = 0;
+				if ( root == NULL ) {
+					for ( size_t i = 0; i < n; i++ )
+						out[i] = NULL;
+					return ;
+				}
+				for ( ; lanes < batch_lanes && next < n; lanes++, next++ ) {
+					node[lanes] = root;
+					key[lanes] = next;
+					out[next] = NULL;
+				}
+				while ( lanes ) {
+					for ( size_t i = 0; i < lanes; ) {
+						tree_node< T >* cur = to_node( node[i] );
+						tree_node_base* child;
+						if ( comp( keys[key[i]], cur->value ) )
+							child = cur->left;
+						else if ( comp( cur->value, keys[key[i]] ) )
+							child = cur->right;
+						else {
+							out[key[i]] = cur;
+							child = NULL;
+						}
+						if ( child ) {
+							tree_prefetch( child );
+							node[i++] = child;
+						}
+						else if ( next < n ) {
+							node[i] = root;
+							key[i++] = next;
+							out[next++] = NULL;
+						}
+						else {
+							lanes--;
+							node[i] = node[lanes];
+							key[i] = key[lanes];
+						}
+					}
+				}
+			}
+
+			/*
+			** search for keys that come in order. finger holds the first node
+			** not ordered before the previous key, the header at the end, and
+			** moves to the one of key. The search climbs from there to the
+			** lowest ancestor whose subtree can hold key and goes down again,
+			** so m sorted keys cost O(m log(n / m)) instead of O(m log n).
+			*/
+			template <class K, class Comp>
+			tree_node< T >* finger_search( tree_node_base** finger, K const & key, Comp comp ) const {
+				tree_node_base* node = *finger;
+				if ( node == &_header )
+					return NULL;
+				if ( !comp( to_node( node )->value, key ) )
+					return comp( key, to_node( node )->value ) ? NULL : to_node( node );
+				tree_node_base* bound = const_cast< tree_node_base* >( &_header );
+				while ( node->getParent() != &_header ) {
+					tree_node_base* parent = node->getParent();
+					if ( node->isLeft() && !comp( to_node( parent )->value, key ) ) {
+						bound = parent;
+						break ;
+					}
+					node = parent;
+				}
+				while ( node ) {
+					if ( comp( to_node( node )->value, key ) )
 						node = node->right;
+					else if ( comp( key, to_node( node )->value ) ) {
+						bound = node;
+						node = node->left;
+					}
 					else {
-						if ( res == NULL || _comparer( node->value, res->value ) )
-							res = node;
+						*finger = node;
+						return to_node( node );
+					}
+				}
+				*finger = bound;
+				if ( bound == &_header || comp( key, to_node( bound )->value ) )
+					return NULL;
+				return to_node( bound );
+			}
+
+			tree_node< T >* lower_search( tree_node< T >* node, T const & key ) const {
+				return lower_search( node, key, _comparer );
+			}
+
+			// k-th smallest value or NULL, O(log n) with ranked nodes and O(k) otherwise
+			tree_node< T >* select( size_t k ) const {
+				if ( k >= _size )
+					return NULL;
+				tree_node_base* node = _header.getParent();
+				if ( !Node::ranked ) {
+					node = _header.left;
+					while ( k-- )
+						node = tree_increment( node );
+					return to_node( node );
+				}
+				while ( k != Node::count( node->left ) ) {
+					if ( k < Node::count( node->left ) )
 						node = node->left;
+					else {
+						k -= Node::count( node->left ) + 1;
+						node = node->right;
 					}
 				}
-				if ( res )
+				return to_node( node );
+			}
+
+			// number of values ordered before key
+			template <class K, class Comp>
+			size_t rank( K const & key, Comp comp ) const {
+				size_t res = 0;
+				tree_node_base* node = _header.getParent();
+				if ( !Node::ranked ) {
+					for ( node = _header.left; node != &_header && comp( to_node( node )->value, key ); node = tree_increment( node ) )
+						res++;
 					return res;
-				return NULL;
+				}
+				while ( node ) {
+					if ( comp( to_node( node )->value, key ) ) {
+						res += Node::count( node->left ) + 1;
+						node = node->right;
+					}
+					else
+						node = node->left;
+				}
+				return res;
 			}
 
-			void del( tree_node< T >* v ) {
-				v = bst_delete( v );
-				iterator it( this, v );
-				if ( v->parent == NULL ) {
-					_first = _root;
-					_last = _root;
+			/*
+			** Aggregate of the values in [lo, hi), only with aggregate nodes.
+			** Below the node where the paths to lo and hi part, each subtree
+			** hanging inside the range counts with its cached total, so it
+			** takes two descents, O(log n).
+			*/
+			template <class K, class Comp>
+			typename Node::aggregate_type aggregate( K const & lo, K const & hi, Comp comp ) const {
+				typedef typename Node::monoid_type monoid;
+				tree_node_base* node = _header.getParent();
+				while ( node ) {
+					if ( comp( to_node( node )->value, lo ) )
+						node = node->right;
+					else if ( !comp( to_node( node )->value, hi ) )
+						node = node->left;
+					else
+						break ;
 				}
-				else {
-					if ( v == _first )
-						_first = search( _root, *(++it) );
-					if ( v == _last )
-						_last = search( _root, *(--it) );
+				if ( node == NULL )
+					return monoid::identity();
+				typename Node::aggregate_type left = monoid::identity();
+				for ( tree_node_base* n = node->left; n; ) {
+					if ( comp( to_node( n )->value, lo ) )
+						n = n->right;
+					else {
+						left = monoid::combine( monoid::combine( monoid::lift( to_node( n )->value ), Node::sum( n->right ) ), left );
+						n = n->left;
+					}
+				}
+				typename Node::aggregate_type right = monoid::identity();
+				for ( tree_node_base* n = node->right; n; ) {
+					if ( !comp( to_node( n )->value, hi ) )
+						n = n->left;
+					else {
+						right = monoid::combine( right, monoid::combine( Node::sum( n->left ), monoid::lift( to_node( n )->value ) ) );
+						n = n->right;
+					}
 				}
-				free_node( v );
+				return monoid::combine( monoid::combine( left, monoid::lift( to_node( node )->value ) ), right );
+			}
+
+			// aggregate of every value, O(1)
+			typename Node::aggregate_type aggregate( void ) const {
+				return Node::sum( _header.getParent() );
+			}
+
+			// recomputes what depends on the value of node after it changed in place
+			void refresh( tree_node_base* node ) {
+				update_path( node );
+			}
+
+			// position of a node in the sequence, end() being at getSize()
+			size_t index( tree_node_base* node ) const {
+				if ( tree_is_header( node ) )
+					return _size;
+				if ( !Node::ranked )
+					return distance( _header.left, node );
+				size_t res = Node::count( node->left );
+				while ( node->getParent() != &_header ) {
+					if ( !node->isLeft() )
+						res += Node::count( node->getParent()->left ) + 1;
+					node = node->getParent();
+				}
+				return res;
+			}
+
+			std::ptrdiff_t distance( tree_node_base* first, tree_node_base* last ) const {
+				if ( Node::ranked )
+					return static_cast< std::ptrdiff_t >( index( last ) ) - static_cast< std::ptrdiff_t >( index( first ) );
+				std::ptrdiff_t res = 0;
+				for ( ; first != last; first = tree_increment( first ) )
+					res++;
+				return res;
+			}
+
+			void del( tree_node< T >* v ) {
+				free_node( extract( v ) );
+			}
+
+			// unlinks v without freeing it, v comes back as a lone red node
+			tree_node< T >* extract( tree_node< T >* v ) {
+				if ( v == _header.left )
+					_header.left = tree_increment( v );
+				if ( v == _header.right )
+					_header.right = tree_decrement( v );
+				bst_delete( v );
 				if ( _size )
 					_size--;
-				while ( _root && _root->parent )
-					_root = _root->parent;
-				if ( _root ) {
-					_root->black = true;
-					_root->isLeft = false;
+				if ( _header.getParent() ) {
+					_header.getParent()->setBlack( true );
+					_header.getParent()->setLeft( false );
+				}
+				v->left = NULL;
+				v->right = NULL;
+				v->setParent( NULL );
+				v->setBlack( false );
+				v->setLeft( false );
+				update( v );
+				return v;
+			}
+
+			/*
+			** Moves over the nodes of x whose value is not in this tree, the
+			** others stay in x. Nothing is allocated or copied unless the
+			** allocators do not compare equal.
+			*/
+			void merge( tree& x ) {
+				if ( this == &x )
+					return ;
+				bool same_allocator = ( _allocator == x._allocator );
+				tree_node_base* next;
+				tree_node_base* parent;
+				bool left;
+				for ( tree_node_base* node = x._header.left; node != &x._header; node = next ) {
+					next = tree_increment( node );
+					if ( find_slot( to_node( node )->value, _comparer, &parent, &left ) )
+						continue ;
+					if ( same_allocator )
+						link_at( parent, left, x.extract( to_node( node ) ) );
+					else {
+						add_at( parent, left, to_node( node )->value );
+						x.del( to_node( node ) );
+					}
 				}
 			}
 
+			/*
+			** Erases [first, last) in O(log n + k). Short ranges are unlinked node
+			** by node, otherwise the tree is split just before first and at last,
+			** the middle part is freed in one go and the outer parts are joined
+			** back with last in between.
+			*/
+			void del_range( tree_node_base* first, tree_node_base* last ) {
+				if ( first == last )
+					return ;
+				if ( first == _header.left && last == &_header )
+					return clear();
+				tree_node_base* node = first;
+				for ( size_t k = 0; k < short_range && node != last; k++ )
+					node = tree_increment( node );
+				if ( node == last ) {
+					while ( first != last ) {
+						node = tree_increment( first );
+						del( to_node( first ) );
+						first = node;
+					}
+					return ;
+				}
+				bool to_end = ( last == &_header );
+				size_t height, left_height, right_height, rest_height;
+				tree_node_base *left, *right, *rest;
+				node_side at_first( first, &_header );
+				tree_node_base* root = take_root( &height );
+				split_by( root, height, at_first, &left, &left_height, &right, &right_height );
+				size_t count = 1;
+				if ( to_end )
+					count += clear( to_node( right ) );
+				else {
+					node_side at_last( last, NULL );
+					split_by( right, right_height, at_last, &right, &right_height, &rest, &rest_height );
+					count += clear( to_node( right ) );
+					left = join( left, left_height, last, rest, rest_height, &height );
+				}
+				free_node( to_node( first ) );
+				_size -= count;
+				adopt( left );
+			}
+
 			void clear( void ) {
-				clear( _root );
+				clear( getRoot() );
 				_size = 0;
-				_first = NULL;
-				_last = NULL;
-				_root = NULL;
+				reset_header();
+				release_allocator( _allocator );
 			}
 
 			void swap( tree & x ) {
-				tree_node< T > *r, *f, *l;
+				tree_node_base *r, *f, *l;
 				size_t s;
 				Alloc a;
 				value_comp v;
-				r = x._root;
-				f = x._first;
-				l = x._last;
-				s = x._size;
-				a = x._allocator;
-				v = x._comparer;
-				x._root = _root;
-				x._first = _first;
-				x._last = _last;
-				x._size = _size;
-				x._comparer = _comparer;
-				x._allocator = _allocator;
-				_root = r;
-				_first = f;
-				_last = l;
-				_size = s;
-				_comparer = v;
-				_allocator = a;
+				r = _header.getParent();
+				f = _header.left;
+				l = _header.right;
+				s = _size;
+				a = _allocator;
+				v = _comparer;
+				set_header( x._header.getParent(), x._header.left, x._header.right );
+				_size = x._size;
+				_allocator = x._allocator;
+				_comparer = x._comparer;
+				x.set_header( r, f, l );
+				x._size = s;
+				x._allocator = a;
+				x._comparer = v;
+			}
+
+			/*
+			** Set algebra through split and join, O(m log(n/m + 1)) for sizes
+			** m <= n. The nodes of both trees are reused and x is left empty; on a
+			** duplicate the value of this tree wins. The two recursive calls of
+			** each step work on disjoint subtrees and could run in parallel.
+			** Allocators that do not compare equal cannot share nodes, the
+			** elements are then moved one by one.
+			*/
+			void set_union( tree& x ) {
+				if ( this == &x )
+					return ;
+				if ( !( _allocator == x._allocator ) ) {
+					bool duplicate;
+					for ( iterator it = x.begin(); it != x.end(); it++ ) {
+						duplicate = false;
+						add( *it, &duplicate );
+					}
+					x.clear();
+					return ;
+				}
+				size_t height, x_height, common = 0;
+				tree_node_base* root = take_root( &height );
+				tree_node_base* x_root = x.take_root( &x_height );
+				root = set_union( root, height, x_root, x_height, &height, &common );
+				_size += x._size - common;
+				x._size = 0;
+				adopt( root );
+			}
+
+			void set_intersection( tree& x ) {
+				if ( this == &x )
+					return ;
+				if ( !( _allocator == x._allocator ) ) {
+					tree_node_base* next;
+					for ( tree_node_base* node = _header.left; node != &_header; node = next ) {
+						next = tree_increment( node );
+						if ( x.search( x.getRoot(), to_node( node )->value ) == NULL )
+							del( to_node( node ) );
+					}
+					x.clear();
+					return ;
+				}
+				size_t height, x_height, common = 0;
+				tree_node_base* root = take_root( &height );
+				tree_node_base* x_root = x.take_root( &x_height );
+				root = set_intersection( root, height, x_root, x_height, &height, &common );
+				_size = common;
+				x._size = 0;
+				adopt( root );
+			}
+
+			void set_difference( tree& x ) {
+				if ( this == &x ) {
+					clear();
+					return ;
+				}
+				if ( !( _allocator == x._allocator ) ) {
+					tree_node< T >* node;
+					for ( iterator it = x.begin(); it != x.end(); it++ )
+						if ( ( node = search( getRoot(), *it ) ) != NULL )
+							del( node );
+					x.clear();
+					return ;
+				}
+				size_t height, x_height, common = 0;
+				tree_node_base* root = take_root( &height );
+				tree_node_base* x_root = x.take_root( &x_height );
+				root = set_difference( root, height, x_root, x_height, &height, &common );
+				_size -= common;
+				x._size = 0;
+				adopt( root );
 			}
 
 		private:
 
-		void copy( tree_node< T >* node ) {
-			bool duplicate = false;
-			if ( node == NULL )
+		// Copies the shape and colors of x's subtree as is, without a single
+		// comparison. Recurses on right children and loops down the left spine,
+		// picking up the copies of x's first and last node on the way.
+		tree_node< T >* clone( const tree_node< T >* node, tree_node_base* parent, const tree& x ) {
+			tree_node< T >* top = clone_node( node, parent, x );
+			tree_node< T >* copy = top;
+			while ( true ) {
+				if ( node->right )
+					copy->right = clone( to_node( node->right ), copy, x );
+				if ( node->left == NULL )
+					return top;
+				node = to_node( node->left );
+				copy->left = clone_node( node, copy, x );
+				copy = to_node( copy->left );
+			}
+		}
+
+		tree_node< T >* clone_node( const tree_node< T >* node, tree_node_base* parent, const tree& x ) {
+			Node* copy = _allocator.allocate( 1 );
+			_allocator.construct( copy, *static_cast< const Node* >( node ) );
+			copy->setParent( parent );
+			copy->left = NULL;
+			copy->right = NULL;
+			if ( node == x._header.left )
+				_header.left = copy;
+			if ( node == x._header.right )
+				_header.right = copy;
+			return copy;
+		}
+
+		// Strictly increasing input: every level is full but the deepest one,
+		// whose nodes are the only red ones so each path has the same black height.
+		void build( const value_buffer& values ) {
+			if ( values.empty() )
 				return ;
-			add( node->value, &duplicate );
-			copy( node->left );
-			copy( node->right );
+			size_t red_depth = 0;
+			for ( size_t n = values.size(); n > 1; n >>= 1 )
+				red_depth++;
+			tree_node_base* root = build( values, 0, values.size(), &_header, 0, red_depth );
+			tree_node_base* first = root;
+			tree_node_base* last = root;
+			while ( first->left )
+				first = first->left;
+			while ( last->right )
+				last = last->right;
+			set_header( root, first, last );
+			_size = values.size();
+		}
+
+		tree_node< T >* build( const value_buffer& values, size_t lo, size_t hi,
+			tree_node_base* parent, size_t depth, size_t red_depth ) {
+			if ( lo == hi )
+				return NULL;
+			size_t mid = lo + ( hi - lo ) / 2;
+			tree_node< T >* node = create_node( values[mid] );
+			node->setParent( parent );
+			node->setBlack( depth == 0 || depth != red_depth );
+			node->left = build( values, lo, mid, node, depth + 1, red_depth );
+			if ( node->left )
+				node->left->setLeft( true );
+			node->right = build( values, mid + 1, hi, node, depth + 1, red_depth );
+			update( node );
+			return node;
+		}
+
+		/*
+		** Split and join work on detached subtrees: no parent, a black root
+		** and a known black height, the number of black nodes on any path from
+		** the root down to a leaf. While a join rebalances, the subtree hangs
+		** from the header so the usual insertion fix-up can be reused.
+		*/
+
+		tree_node_base* take_root( size_t* height ) {
+			tree_node_base* root = _header.getParent();
+			*height = 0;
+			for ( tree_node_base* node = root; node; node = node->left )
+				*height += node->isBlack();
+			reset_header();
+			if ( root )
+				root->setParent( NULL );
+			return root;
 		}
 
-		void clear( tree_node< T >* node ) {
+		void adopt( tree_node_base* root ) {
+			if ( root == NULL )
+				return reset_header();
+			tree_node_base* first = root;
+			tree_node_base* last = root;
+			while ( first->left )
+				first = first->left;
+			while ( last->right )
+				last = last->right;
+			set_header( root, first, last );
+		}
+
+		static tree_node_base* detach( tree_node_base* node, size_t* height ) {
 			if ( node == NULL )
-				return ;
-			clear( node->left );
-			clear( node->right );
-			free_node( node );
-			node = NULL;
+				return NULL;
+			node->setParent( NULL );
+			node->setLeft( false );
+			if ( !node->isBlack() ) {
+				node->setBlack( true );
+				( *height )++;
+			}
+			return node;
 		}
 
-			tree_node< T > * add( tree_node< T > * parent, tree_node< T > * new_node, bool *duplicate ) {
-				if ( !_comparer( parent->value, new_node->value ) && !_comparer( new_node->value, parent->value ) ) {
-					*duplicate = true;
-					return parent;
-				}
-				if ( _comparer( parent->value, new_node->value ) ) {
-					if ( parent->right == NULL ) {
-						parent->right = new_node;
-						new_node->parent = parent;
-						new_node->isLeft = false;
-						return new_node;
-					}
-					return add( parent->right, new_node, duplicate );
+		static void link( tree_node_base* parent, tree_node_base* child, bool isLeft ) {
+			if ( isLeft )
+				parent->left = child;
+			else
+				parent->right = child;
+			if ( child ) {
+				child->setParent( parent );
+				child->setLeft( isLeft );
+			}
+		}
+
+		// every value of left is ordered before node, every value of right after it
+		tree_node_base* join( tree_node_base* left, size_t left_height, tree_node_base* node,
+			tree_node_base* right, size_t right_height, size_t* height ) {
+			if ( left_height == right_height ) {
+				link( node, left, true );
+				link( node, right, false );
+				node->setParent( NULL );
+				node->setLeft( false );
+				node->setBlack( true );
+				update( node );
+				*height = left_height + 1;
+				return node;
+			}
+			bool taller_left = left_height > right_height;
+			tree_node_base* top = taller_left ? left : right;
+			size_t top_height = taller_left ? left_height : right_height;
+			size_t target = taller_left ? right_height : left_height;
+			_header.setParent( top );
+			top->setParent( &_header );
+			// walk down the inner spine of the taller tree to a black node as high as the other one
+			tree_node_base* parent = top;
+			tree_node_base* cut = taller_left ? top->right : top->left;
+			size_t cut_height = top_height - 1;
+			while ( cut_height > target || ( cut && !cut->isBlack() ) ) {
+				cut_height -= cut->isBlack();
+				parent = cut;
+				cut = taller_left ? cut->right : cut->left;
+			}
+			link( node, taller_left ? cut : left, true );
+			link( node, taller_left ? right : cut, false );
+			link( parent, node, !taller_left );
+			node->setBlack( false );
+			update( node );
+			update_path( parent );
+			check_color( node );
+			tree_node_base* root = _header.getParent();
+			*height = top_height;
+			if ( !root->isBlack() ) {
+				root->setBlack( true );
+				( *height )++;
+			}
+			reset_header();
+			root->setParent( NULL );
+			return root;
+		}
+
+		// join without a middle node: the last node of left takes its place
+		tree_node_base* join( tree_node_base* left, size_t left_height,
+			tree_node_base* right, size_t right_height, size_t* height ) {
+			if ( left == NULL ) {
+				*height = right_height;
+				return right;
+			}
+			tree_node_base* last;
+			left = split_last( left, left_height, &last, &left_height );
+			return join( left, left_height, last, right, right_height, height );
+		}
+
+		tree_node_base* split_last( tree_node_base* node, size_t node_height, tree_node_base** last, size_t* height ) {
+			size_t child_height = node_height - node->isBlack();
+			size_t left_height = child_height;
+			tree_node_base* left = detach( node->left, &left_height );
+			if ( node->right == NULL ) {
+				*last = node;
+				*height = left_height;
+				return left;
+			}
+			tree_node_base* right = split_last( node->right, child_height, last, height );
+			return join( left, left_height, node, right, *height, height );
+		}
+
+		// where a split point lies from a node: before it (< 0), after it (> 0) or at it
+		class key_side {
+
+			public:
+
+				key_side( T const & key, const value_comp& comp ) : _key( key ), _comp( comp ) {}
+
+				int operator()( const tree_node_base* node ) {
+					if ( _comp( _key, to_node( node )->value ) )
+						return -1;
+					if ( _comp( to_node( node )->value, _key ) )
+						return 1;
+					return 0;
 				}
-				if ( parent->left == NULL ) {
-					parent->left = new_node;
-					new_node->parent = parent;
-					new_node->isLeft = true;
-					return new_node;
+
+			private:
+
+				T const &			_key;
+				const value_comp&	_comp;
+
+		};
+
+		/*
+		** Same for one given node, found by the turns taken from the root
+		** down to it rather than by its value, so it also works among equal
+		** values. A red-black tree is at most 2 log2(n + 1) deep.
+		*/
+		class node_side {
+
+			public:
+
+				// top is the parent of the root of the subtree holding node
+				node_side( const tree_node_base* node, const tree_node_base* top ) : _depth( 0 ) {
+					for ( ; node->getParent() != top; node = node->getParent() )
+						_left[_depth++] = node->isLeft();
 				}
-				return add( parent->left, new_node, duplicate );
+
+				int operator()( const tree_node_base* ) {
+					if ( _depth == 0 )
+						return 0;
+					return _left[--_depth] ? -1 : 1;
+				}
+
+			private:
+
+				bool	_left[2 * sizeof( size_t ) * 8];
+				size_t	_depth;
+
+		};
+
+		tree_node_base* split( tree_node_base* node, size_t node_height, T const & key,
+			tree_node_base** left, size_t* left_height, tree_node_base** right, size_t* right_height ) {
+			key_side side( key, _comparer );
+			return split_by( node, node_height, side, left, left_height, right, right_height );
+		}
+
+		/*
+		** Splits a detached subtree around the point side leads to, into the
+		** values ordered before and after it. Returns the node at that point
+		** if there is one.
+		*/
+		template <class Side>
+		tree_node_base* split_by( tree_node_base* node, size_t node_height, Side& side,
+			tree_node_base** left, size_t* left_height, tree_node_base** right, size_t* right_height ) {
+			if ( node == NULL ) {
+				*left = NULL;
+				*right = NULL;
+				*left_height = 0;
+				*right_height = 0;
+				return NULL;
+			}
+			size_t child_height = node_height - node->isBlack();
+			size_t height = child_height;
+			tree_node_base* found;
+			int where = side( node );
+			if ( where < 0 ) {
+				tree_node_base* rest = detach( node->right, &height );
+				found = split_by( node->left, child_height, side, left, left_height, right, right_height );
+				*right = join( *right, *right_height, node, rest, height, right_height );
+				return found;
+			}
+			if ( where > 0 ) {
+				tree_node_base* rest = detach( node->left, &height );
+				found = split_by( node->right, child_height, side, left, left_height, right, right_height );
+				*left = join( rest, height, node, *left, *left_height, left_height );
+				return found;
+			}
+			*left_height = child_height;
+			*right_height = child_height;
+			*left = detach( node->left, left_height );
+			*right = detach( node->right, right_height );
+			return node;
+		}
+
+		tree_node_base* set_union( tree_node_base* a, size_t a_height, tree_node_base* b, size_t b_height,
+			size_t* height, size_t* common ) {
+			if ( a == NULL || b == NULL ) {
+				*height = a ? a_height : b_height;
+				return a ? a : b;
+			}
+			tree_node_base *left, *right;
+			size_t left_height, right_height;
+			tree_node_base* same = split( b, b_height, to_node( a )->value, &left, &left_height, &right, &right_height );
+			if ( same ) {
+				free_node( to_node( same ) );
+				( *common )++;
+			}
+			size_t child_height = a_height - a->isBlack();
+			size_t a_left_height = child_height;
+			size_t a_right_height = child_height;
+			tree_node_base* a_left = detach( a->left, &a_left_height );
+			tree_node_base* a_right = detach( a->right, &a_right_height );
+			left = set_union( a_left, a_left_height, left, left_height, &left_height, common );
+			right = set_union( a_right, a_right_height, right, right_height, &right_height, common );
+			return join( left, left_height, a, right, right_height, height );
+		}
+
+		tree_node_base* set_intersection( tree_node_base* a, size_t a_height, tree_node_base* b, size_t b_height,
+			size_t* height, size_t* common ) {
+			if ( a == NULL || b == NULL ) {
+				clear( to_node( a ) );
+				clear( to_node( b ) );
+				*height = 0;
+				return NULL;
+			}
+			tree_node_base *left, *right;
+			size_t left_height, right_height;
+			tree_node_base* same = split( b, b_height, to_node( a )->value, &left, &left_height, &right, &right_height );
+			size_t child_height = a_height - a->isBlack();
+			size_t a_left_height = child_height;
+			size_t a_right_height = child_height;
+			tree_node_base* a_left = detach( a->left, &a_left_height );
+			tree_node_base* a_right = detach( a->right, &a_right_height );
+			left = set_intersection( a_left, a_left_height, left, left_height, &left_height, common );
+			right = set_intersection( a_right, a_right_height, right, right_height, &right_height, common );
+			if ( same ) {
+				free_node( to_node( same ) );
+				( *common )++;
+				return join( left, left_height, a, right, right_height, height );
+			}
+			free_node( to_node( a ) );
+			return join( left, left_height, right, right_height, height );
+		}
+
+		tree_node_base* set_difference( tree_node_base* a, size_t a_height, tree_node_base* b, size_t b_height,
+			size_t* height, size_t* common ) {
+			if ( a == NULL || b == NULL ) {
+				clear( to_node( b ) );
+				*height = a ? a_height : 0;
+				return a;
+			}
+			tree_node_base *left, *right;
+			size_t left_height, right_height;
+			tree_node_base* same = split( a, a_height, to_node( b )->value, &left, &left_height, &right, &right_height );
+			if ( same ) {
+				free_node( to_node( same ) );
+				( *common )++;
+			}
+			size_t child_height = b_height - b->isBlack();
+			size_t b_left_height = child_height;
+			size_t b_right_height = child_height;
+			tree_node_base* b_left = detach( b->left, &b_left_height );
+			tree_node_base* b_right = detach( b->right, &b_right_height );
+			free_node( to_node( b ) );
+			left = set_difference( left, left_height, b_left, b_left_height, &left_height, common );
+			right = set_difference( right, right_height, b_right, b_right_height, &right_height, common );
+			return join( left, left_height, right, right_height, height );
+		}
+
+		// frees a whole subtree, returns how many nodes it had
+		size_t clear( tree_node< T >* node ) {
+			if ( node == NULL )
+				return 0;
+			size_t count = clear( to_node( node->left ) ) + clear( to_node( node->right ) );
+			free_node( node );
+			return count + 1;
+		}
+
+			void reset_header( void ) {
+				_header.setParent( NULL );
+				_header.setBlack( false );
+				_header.setLeft( false );
+				_header.left = &_header;
+				_header.right = &_header;
+			}
+
+			void set_header( tree_node_base* root, tree_node_base* first, tree_node_base* last ) {
+				if ( root == NULL )
+					return reset_header();
+				_header.setParent( root );
+				_header.left = first;
+				_header.right = last;
+				root->setParent( &_header );
+			}
+
+			// links in a freshly added leaf and rebalances
+			tree_node< T >* attach( tree_node< T >* node ) {
+				if ( node->isLeft() && node->getParent() == _header.left )
+					_header.left = node;
+				else if ( !node->isLeft() && node->getParent() == _header.right )
+					_header.right = node;
+				update_path( node->getParent() );
+				check_color( node );
+				_header.getParent()->setBlack( true );
+				_size++;
+				return node;
 			}
 
 			bool check_duplicates( T p ) {
@@ -356,279 +1514,269 @@ namespace ft {
 				return false;
 			}
 			
-			void check_color( tree_node< T > * node ) {
-				if ( node == _root )
-					return ;
-				if ( !node->black && !node->parent->black )
-					correct_tree( node );
-				if ( node == _root )
-					return ;
-				check_color( node->parent ); 
+			// node is red; walk up while it has a red parent. Recoloring moves the
+			// violation to the grandparent, a rotation ends it.
+			void check_color( tree_node_base * node ) {
+				while ( node != _header.getParent() && !node->getParent()->isBlack() ) {
+					if ( !correct_tree( node ) )
+						return ;
+					node = node->getParent()->getParent();
+				}
 			}
 
-			void correct_tree( tree_node< T > * node ) {
-				if ( node->parent->isLeft ) { // aunt is node->parent->parent->right
-					if ( node->parent->parent->right == NULL || node->parent->parent->right->black )
-						return rotate( node );
-					if ( node->parent->parent->right != NULL )
-						node->parent->parent->right->black = true;
-					node->parent->parent->black = false;
-					node->parent->black = true;
-					return ;
+			bool correct_tree( tree_node_base * node ) {
+				tree_node_base * aunt;
+				if ( node->getParent()->isLeft() )
+					aunt = node->getParent()->getParent()->right;
+				else
+					aunt = node->getParent()->getParent()->left;
+				if ( aunt == NULL || aunt->isBlack() ) {
+					rotate( node );
+					return false;
 				}
-				// aunt is node->parent->parent->left
-				if ( node->parent->parent->left == NULL || node->parent->parent->left->black )
-					return rotate( node );
-				if ( node->parent->parent->left != NULL )
-					node->parent->parent->left->black = true;
-				node->parent->parent->black = false;
-				node->parent->black = true;
-			}
-
-			void rotate( tree_node< T > * node ) {
-				if ( node->isLeft ) {
-					if ( node->parent->isLeft ) {
-						right_rotate( node->parent->parent );
-						node->black = false;
-						node->parent->black = true;
-						if ( node->parent->right != NULL )
-							node->parent->right->black = false;
+				aunt->setBlack( true );
+				node->getParent()->getParent()->setBlack( false );
+				node->getParent()->setBlack( true );
+				return true;
+			}
+
+			void rotate( tree_node_base * node ) {
+				if ( node->isLeft() ) {
+					if ( node->getParent()->isLeft() ) {
+						right_rotate( node->getParent()->getParent() );
+						node->setBlack( false );
+						node->getParent()->setBlack( true );
+						if ( node->getParent()->right != NULL )
+							node->getParent()->right->setBlack( false );
 						return ;
 					}
-					rightleft_rotate( node->parent->parent );
-					node->black = true;
-					node->right->black = false;
-					node->left->black = false;
+					rightleft_rotate( node->getParent()->getParent() );
+					node->setBlack( true );
+					node->right->setBlack( false );
+					node->left->setBlack( false );
 					return ;
 				}
-				if ( node->parent->isLeft ) {
-					leftright_rotate( node->parent->parent );
-					node->black = true;
-					node->right->black = false;
-					node->left->black = false;
+				if ( node->getParent()->isLeft() ) {
+					leftright_rotate( node->getParent()->getParent() );
+					node->setBlack( true );
+					node->right->setBlack( false );
+					node->left->setBlack( false );
 					return ;
 				}
-				left_rotate( node->parent->parent );
-				node->black = false;
-				node->parent->black = true;
-				if ( node->parent->left != NULL )
-					node->parent->left->black = false;
+				left_rotate( node->getParent()->getParent() );
+				node->setBlack( false );
+				node->getParent()->setBlack( true );
+				if ( node->getParent()->left != NULL )
+					node->getParent()->left->setBlack( false );
 			}
 
-			void left_rotate( tree_node< T > * node ) {
-				tree_node< T > * temp = node->right;
+			void left_rotate( tree_node_base * node ) {
+				tree_node_base * temp = node->right;
 				node->right = temp->left;
 				if ( node->right != NULL ) {
-					node->right->parent = node;
-					node->right->isLeft = false;
+					node->right->setParent( node );
+					node->right->setLeft( false );
 				}
-				if ( node->parent == NULL ) { // we are the root node
-					_root = temp;
-					temp->parent = NULL;
+				temp->setParent( node->getParent() );
+				if ( node == _header.getParent() ) {
+					_header.setParent( temp );
+					temp->setLeft( false );
+				}
+				else if ( node->isLeft() ) {
+					temp->setLeft( true );
+					temp->getParent()->left = temp;
 				}
 				else {
-					temp->parent = node->parent;
-					if ( node->isLeft ) {
-						temp->isLeft = true;
-						temp->parent->left = temp;
-					}
-					else {
-						temp->isLeft = false;
-						temp->parent->right = temp;
-					}
+					temp->setLeft( false );
+					temp->getParent()->right = temp;
 				}
 				temp->left = node;
-				node->isLeft = true;
-				node->parent = temp;
+				node->setLeft( true );
+				node->setParent( temp );
+				update( node );
+				update( temp );
 			}
 
-			void right_rotate( tree_node< T > * node ) {
-				tree_node< T > * temp = node->left;
+			void right_rotate( tree_node_base * node ) {
+				tree_node_base * temp = node->left;
 				node->left = temp->right;
 				if ( node->left != NULL ) {
-					node->left->parent = node;
-					node->left->isLeft = true;
+					node->left->setParent( node );
+					node->left->setLeft( true );
+				}
+				temp->setParent( node->getParent() );
+				if ( node == _header.getParent() ) {
+					_header.setParent( temp );
+					temp->setLeft( false );
 				}
-				if ( node->parent == NULL ) { // we are a root node
-					_root = temp;
-					temp->parent = NULL;
+				else if ( node->isLeft() ) {
+					temp->setLeft( true );
+					temp->getParent()->left = temp;
 				}
 				else {
-					temp->parent = node->parent;
-					if ( node->isLeft ) {
-						temp->isLeft = true;
-						temp->parent->left = temp;
-					}
-					else {
-						temp->isLeft = false;
-						temp->parent->right = temp;
-					}
+					temp->setLeft( false );
+					temp->getParent()->right = temp;
 				}
 				temp->right = node;
-				node->isLeft = false;
-				node->parent = temp;
+				node->setLeft( false );
+				node->setParent( temp );
+				update( node );
+				update( temp );
 			}
 
-			void leftright_rotate( tree_node< T > * node ) {
+			void leftright_rotate( tree_node_base * node ) {
 				left_rotate( node->left );
 				right_rotate( node );
 			}
 
-			void rightleft_rotate( tree_node< T > * node ) {
+			void rightleft_rotate( tree_node_base * node ) {
 				right_rotate( node->right );
 				left_rotate( node );
 			}
 
-			void handle_double_black( tree_node< T >* p ) {
-				tree_node< T> *x, *y, *z;
-				z = p->parent;
-				if ( p->isLeft )
+			void handle_double_black( tree_node_base* p ) {
+				tree_node_base *x, *y, *z;
+				z = p->getParent();
+				if ( p->isLeft() )
 					y = z->right;
 				else
 					y = z->left;
 				x = NULL;
-				if ( y && y->right && !y->right->black )
+				if ( y && y->right && !y->right->isBlack() )
 					x = y->right;
-				if ( y && y->left && !y->left->black )
+				if ( y && y->left && !y->left->isBlack() )
 					x = y->left;
 				solve_no_double_black( x, y, z, p );
 			}
 
-			void solve_no_double_black( tree_node< T >* x, tree_node< T >* y, tree_node< T >* z, tree_node< T >* p ) {
-				if ( x && y->black ) {
-					x->black = true;
-					y->black = z->black;
-					z->black = true;
+			void solve_no_double_black( tree_node_base* x, tree_node_base* y, tree_node_base* z, tree_node_base* p ) {
+				if ( x && y->isBlack() ) {
+					x->setBlack( true );
+					y->setBlack( z->isBlack() );
+					z->setBlack( true );
 					rotate_double_black( y, x );
 				}
-				else if ( y == NULL || ( y->black && ( ( !y->left || y->left->black ) && ( !y->right || y->right->black ) ) ) ) {
+				else if ( y == NULL || ( y->isBlack() && ( ( !y->left || y->left->isBlack() ) && ( !y->right || y->right->isBlack() ) ) ) ) {
 					if ( y )
-						y->black = false;
-					if ( !z->black )
-						z->black = true;
-					else if ( z != _root )
+						y->setBlack( false );
+					if ( !z->isBlack() )
+						z->setBlack( true );
+					else if ( z != _header.getParent() )
 						handle_double_black( z );
 				}
-				else if ( y && !y->black ) {
-					y->parent = z->parent;
-					z->parent = y;
-					if ( y->parent && z->isLeft )
-						y->parent->left = y;
-					else if ( y->parent )
-						y->parent->right = y;
-					if ( y->isLeft ) {
-						y->isLeft = z->isLeft;
-						z->left = y->right;
-						if ( y->right ) {
-							y->right->parent = z;
-							y->right->isLeft = true;
-						}
-						y->right = z;
-						z->isLeft = false;
-					}
-					else {
-						y->isLeft = z->isLeft;
-						z->right = y->left;
-						if ( y->left ) {
-							y->left->parent = z;
-							y->left->isLeft = false;
-						}
-						y->left = z;
-						z->isLeft = true;
-					}
-					y->black = true;
-					z->black = false;
+				else if ( y && !y->isBlack() ) {
+					if ( y->isLeft() )
+						right_rotate( z );
+					else
+						left_rotate( z );
+					y->setBlack( true );
+					z->setBlack( false );
 					handle_double_black( p );
 				}
 			}
 
-			tree_node< T >* bst_delete_no_leaf( tree_node< T >* p ) {
-				if ( p == _root ) {
-					_root = NULL;
+			tree_node_base* bst_delete_no_leaf( tree_node_base* p ) {
+				if ( p == _header.getParent() ) {
+					reset_header();
 					return p;
 				}
-				if ( !p->black ) {
-					if ( p->isLeft )
-						p->parent->left = NULL;
+				if ( !p->isBlack() ) {
+					if ( p->isLeft() )
+						p->getParent()->left = NULL;
 					else
-						p->parent->right = NULL;
+						p->getParent()->right = NULL;
+					update_path( p->getParent() );
 					return p;
 				}
-				if ( p->isLeft ) {
-					p->parent->left = NULL;
+				if ( p->isLeft() ) {
+					p->getParent()->left = NULL;
 				}
 				else {
-					p->parent->right = NULL;
+					p->getParent()->right = NULL;
 				}
+				update_path( p->getParent() );
 				handle_double_black( p );
 				return p;
 			}
 
-			tree_node< T >* bst_delete_left_leaf( tree_node< T >* node ) {
-				if ( node->parent == NULL ) {
-					_root = node->left;
-					node->left->parent = NULL;
-					node->left->isLeft = false;
+			tree_node_base* bst_delete_left_leaf( tree_node_base* node ) {
+				if ( node == _header.getParent() ) {
+					_header.setParent( node->left );
+					node->left->setParent( &_header );
+					node->left->setLeft( false );
 					return node;
 				}
-				if ( node->isLeft )
-					node->parent->left = node->left;
+				if ( node->isLeft() )
+					node->getParent()->left = node->left;
 				else {
-					node->parent->right = node->left;
-					node->left->isLeft = false;
+					node->getParent()->right = node->left;
+					node->left->setLeft( false );
 				}
-				node->left->parent = node->parent;
-				if ( node->black )
-					node->left->black = true;
+				node->left->setParent( node->getParent() );
+				if ( node->isBlack() )
+					node->left->setBlack( true );
+				update_path( node->getParent() );
 				return node;
 			}
 
-			tree_node< T >* bst_delete_right_leaf( tree_node< T >* node ) {
-				if ( node->parent == NULL ) {
-					_root = node->right;
-					node->right->parent = NULL;
+			tree_node_base* bst_delete_right_leaf( tree_node_base* node ) {
+				if ( node == _header.getParent() ) {
+					_header.setParent( node->right );
+					node->right->setParent( &_header );
 					return node;
 				}
-				if ( node->isLeft ) {
-					node->parent->left = node->right;
-					node->right->isLeft = true;
+				if ( node->isLeft() ) {
+					node->getParent()->left = node->right;
+					node->right->setLeft( true );
 				}
 				else
-					node->parent->right = node->right;
-				node->right->parent = node->parent;
-				if ( node->black )
-					node->right->black = true;
+					node->getParent()->right = node->right;
+				node->right->setParent( node->getParent() );
+				if ( node->isBlack() )
+					node->right->setBlack( true );
+				update_path( node->getParent() );
 				return node;
 			}
 
-			void swap_values_color( tree_node< T >* p, tree_node< T >* r ) {
-				T tmp;
-				bool color;
-				tmp = p->value;
-				p->value = r->value;
-				r->value = tmp;
-				color = p->black;
-				p->black = r->black;
-				r->black = color;
+			// node trades places with its predecessor and is then unlinked from there
+			tree_node_base* bst_delete_two_leaf( tree_node_base* node ) {
+				tree_node_base* prev = node->left;
+				while ( prev->right )
+					prev = prev->right;
+				exchange( node, prev );
+				return bst_delete( node );
 			}
 
-			void swap_values( tree_node< T >* p, tree_node< T >* r ) {
-				T tmp;
-				tmp = p->value;
-				p->value = r->value;
-				r->value = tmp;
-			}
-
-			tree_node< T >* bst_delete_two_leaf( tree_node< T >* node ) {
-				tree_node< T >* next = node->left;
-				while ( next->right )
-					next = next->right;
-				swap_values( node, next );
-				bst_delete( next );
-				return next;
+			/*
+			** Swaps the positions and colors of node and prev, the last node of
+			** its left subtree, by relinking them. Values never move, so nothing
+			** is copied and iterators stay on their element.
+			*/
+			void exchange( tree_node_base* node, tree_node_base* prev ) {
+				tree_node_base* prev_parent = prev->getParent();
+				tree_node_base* prev_left = prev->left;
+				bool black = prev->isBlack();
+				prev->setBlack( node->isBlack() );
+				node->setBlack( black );
+				if ( node == _header.getParent() ) {
+					_header.setParent( prev );
+					prev->setParent( &_header );
+					prev->setLeft( false );
+				}
+				else
+					link( node->getParent(), prev, node->isLeft() );
+				link( prev, node->right, false );
+				if ( prev_parent == node )
+					link( prev, node, true );
+				else {
+					link( prev, node->left, true );
+					link( prev_parent, node, false );
+				}
+				link( node, prev_left, true );
+				node->right = NULL;
 			}
 
-			tree_node< T >* bst_delete( tree_node< T > * node ) {
+			tree_node_base* bst_delete( tree_node_base * node ) {
 				if ( node->left != NULL && node->right == NULL )
 					return bst_delete_left_leaf( node );
 				else if ( node->left == NULL && node->right != NULL )
@@ -638,30 +1786,59 @@ namespace ft {
 				return bst_delete_no_leaf( node );	
 			}
 
-			void rotate_double_black( tree_node< T >* s, tree_node< T >* r ) {
+			void rotate_double_black( tree_node_base* s, tree_node_base* r ) {
 				bool color;
-				if ( s->isLeft && r->isLeft )
-					right_rotate( s->parent );
-				else if ( s->isLeft && !r->isLeft ) {
-					leftright_rotate( s->parent );
-					color = s->black;
-					s->black = r->black;
-					r->black = color;
-				}
-				else if ( !s->isLeft && !r->isLeft )
-					left_rotate( s->parent );
+				if ( s->isLeft() && r->isLeft() )
+					right_rotate( s->getParent() );
+				else if ( s->isLeft() && !r->isLeft() ) {
+					leftright_rotate( s->getParent() );
+					color = s->isBlack();
+					s->setBlack( r->isBlack() );
+					r->setBlack( color );
+				}
+				else if ( !s->isLeft() && !r->isLeft() )
+					left_rotate( s->getParent() );
 				else {
-					rightleft_rotate( s->parent );
-					color = s->black;
-					s->black = r->black;
-					r->black = color;
+					rightleft_rotate( s->getParent() );
+					color = s->isBlack();
+					s->setBlack( r->isBlack() );
+					r->setBlack( color );
 				}
 			}
 
+			static tree_node< T >* to_node( tree_node_base* node ) {
+				return static_cast< tree_node< T >* >( node );
+			}
+
+			static const tree_node< T >* to_node( const tree_node_base* node ) {
+				return static_cast< const tree_node< T >* >( node );
+			}
+
+			tree_node< T >* create_node( const T& val ) {
+				Node* node = _allocator.allocate( 1 );
+				_allocator.construct( node, Node( val ) );
+				return node;
+			}
+
 			void free_node( tree_node< T > * node ) {
 				if ( node ) {
-					_allocator.destroy( node );
-					_allocator.deallocate( node, 1 );
+					_allocator.destroy( static_cast< Node* >( node ) );
+					_allocator.deallocate( static_cast< Node* >( node ), 1 );
+				}
+			}
+
+			void update( tree_node_base* node ) const {
+				if ( Node::augmented )
+					static_cast< Node* >( node )->update( _comparer );
+			}
+
+			// refreshes the augmentation of node and all of its ancestors
+			void update_path( tree_node_base* node ) {
+				if ( !Node::augmented )
+					return ;
+				while ( node != &_header ) {
+					update( node );
+					node = node->getParent();
 				}
 			}
 
@@ -679,9 +1856,7 @@ namespace ft {
 		pair( void ) {}
 
 		template<class U, class V>
-		pair( const pair<U,V>& pr ) {
-			*this = pr;
-		}
+		pair( const pair<U,V>& pr ) : first( pr.first ), second( pr.second ) {}
 
 		pair( const first_type& a, const second_type& b ) : first( a ), second( b ) {}
 
@@ -36,6 +36,23 @@ namespace ft {
 
 	template<typename T> struct is_integral : public is_integral_base<T> {};
 
+	// true when T declares an is_transparent member type, as ft::less<> does
+	template <class T>
+	struct has_is_transparent {
+		private:
+			typedef char	yes;
+			typedef long	no;
+			template <class U> static yes test( typename U::is_transparent* );
+			template <class U> static no test( ... );
+		public:
+			static const bool value = sizeof( test<T>( 0 ) ) == sizeof( yes );
+	};
+
+	// R for lookups by a key of type K through Compare, only if Compare is
+	// transparent. Depending on K defers the check to the call.
+	template <class Compare, class K, class R>
+	struct enable_if_transparent : enable_if< has_is_transparent<Compare>::value, R > {};
+
 }
 
 #endif
\ No newline at end of file
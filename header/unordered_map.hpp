@@ -0,0 +1,268 @@
+#ifndef UNORDERED_MAP_HPP
+#define UNORDERED_MAP_HPP
+
+#include "hash_table.hpp"
+
+namespace ft {
+
+	/*
+	** Map without order on top of an open addressing hash table: a lookup
+	** costs one hash and usually one key comparison instead of O(log n)
+	** comparisons. Inserts may rehash and invalidate every iterator, erases
+	** only invalidate the erased one.
+	*/
+	template < class Key, class T, class Hash = ft::hash<Key>, class Pred = std::equal_to<Key>, class Alloc = std::allocator< pair< const Key, T > > >
+	class unordered_map {
+
+		public:
+
+			/************************************* Typedefs ******************************************/
+
+			typedef Key																					key_type;
+			typedef T																					mapped_type;
+			typedef Hash																				hasher;
+			typedef Pred																				key_equal;
+			typedef pair< key_type, mapped_type >														value_type;
+			typedef Alloc																				allocator_type;
+			typedef typename allocator_type::template rebind< value_type >::other						value_alloc;
+			typedef typename allocator_type::reference													reference;
+			typedef typename allocator_type::const_reference											const_reference;
+			typedef typename allocator_type::pointer													pointer;
+			typedef typename allocator_type::const_pointer												const_pointer;
+			typedef ft::hash_table< value_type, key_type, hash_select_first, hasher, key_equal, value_alloc >	table_type;
+			typedef typename table_type::iterator														iterator;
+			typedef typename table_type::const_iterator													const_iterator;
+			typedef std::ptrdiff_t																		difference_type;
+			typedef size_t																				size_type;
+
+		private:
+
+			allocator_type _allocator;
+			table_type _table;
+
+		public:
+
+			/************************************* Constructors **************************************/
+
+			explicit unordered_map( size_type n = 0, const hasher& hf = hasher(), const key_equal& eql = key_equal(), const allocator_type& alloc = allocator_type() )
+			: _allocator( alloc ), _table( hf, eql, alloc ) {
+				_table.reserve( n );
+			}
+
+			template <class InputIterator>
+			unordered_map( InputIterator first, InputIterator last, size_type n = 0, const hasher& hf = hasher(), const key_equal& eql = key_equal(), const allocator_type& alloc = allocator_type() )
+			: _allocator( alloc ), _table( hf, eql, alloc ) {
+				_table.reserve( n );
+				insert( first, last );
+			}
+
+			unordered_map( const unordered_map& x ) : _allocator( x._allocator ), _table( x._table ) {}
+
+			/************************************* Destructor ****************************************/
+
+			~unordered_map( void ) {}
+
+			/************************************* Operator = ****************************************/
+
+			unordered_map& operator=( const unordered_map& x ) {
+				_table = x._table;
+				_allocator = x._allocator;
+				return *this;
+			}
+
+			/************************************* Iterators *****************************************/
+
+			iterator begin( void ) {
+				return _table.begin();
+			}
+
+			const_iterator begin( void ) const {
+				return _table.begin();
+			}
+
+			iterator end( void ) {
+				return _table.end();
+			}
+
+			const_iterator end( void ) const {
+				return _table.end();
+			}
+
+			/************************************* Capacity ******************************************/
+
+			bool empty( void ) const {
+				return ( _table.getSize() == 0 ) ? true : false;
+			}
+
+			size_type size( void ) const {
+				return _table.getSize();
+			}
+
+			size_type max_size( void ) const {
+				return _table.getAllocator().max_size();
+			}
+
+			/************************************* Element access ************************************/
+
+			mapped_type& operator[]( const key_type& k ) {
+				return try_emplace( k ).first->second;
+			}
+
+			/************************************* Modifiers *****************************************/
+
+			pair<iterator, bool> insert( const value_type& val ) {
+				bool duplicate = false;
+				iterator it = _table.add( val, &duplicate );
+				return ft::make_pair<iterator, bool>( it, !duplicate );
+			}
+
+			// the position does not help a hash table
+			iterator insert( const_iterator, const value_type& val ) {
+				return insert( val ).first;
+			}
+
+			template <class InputIterator>
+			void insert( InputIterator first, InputIterator last ) {
+				while ( first != last ) {
+					insert( *first );
+					first++;
+				}
+			}
+
+			pair<iterator, bool> try_emplace( const key_type& k ) {
+				size_t hash;
+				size_t index;
+				if ( _table.find_slot( k, &hash, &index ) )
+					return ft::make_pair( _table.to_iterator( index ), false );
+				return ft::make_pair( _table.add_at( index, hash, value_type( k, mapped_type() ) ), true );
+			}
+
+			template <class M>
+			pair<iterator, bool> try_emplace( const key_type& k, const M& obj ) {
+				size_t hash;
+				size_t index;
+				if ( _table.find_slot( k, &hash, &index ) )
+					return ft::make_pair( _table.to_iterator( index ), false );
+				return ft::make_pair( _table.add_at( index, hash, value_type( k, obj ) ), true );
+			}
+
+			template <class M>
+			pair<iterator, bool> insert_or_assign( const key_type& k, const M& obj ) {
+				size_t hash;
+				size_t index;
+				if ( _table.find_slot( k, &hash, &index ) ) {
+					iterator it = _table.to_iterator( index );
+					it->second = obj;
+					return ft::make_pair( it, false );
+				}
+				return ft::make_pair( _table.add_at( index, hash, value_type( k, obj ) ), true );
+			}
+
+			// returns the iterator to the next element, the others stay valid
+			iterator erase( const_iterator position ) {
+				iterator it( position.getCtrl(), position.getSlot() );
+				_table.del( it++ );
+				return it;
+			}
+
+			size_type erase( const key_type& k ) {
+				iterator it = _table.search( k );
+				if ( it == end() )
+					return 0;
+				_table.del( it );
+				return 1;
+			}
+
+			iterator erase( const_iterator first, const_iterator last ) {
+				iterator it( last.getCtrl(), last.getSlot() );
+				_table.del_range( iterator( first.getCtrl(), first.getSlot() ), it );
+				return it;
+			}
+
+			void swap( unordered_map& x ) {
+				allocator_type a = _allocator;
+				_allocator = x._allocator;
+				x._allocator = a;
+				_table.swap( x._table );
+			}
+
+			// destroys the values but keeps the slots
+			void clear( void ) {
+				_table.clear();
+			}
+
+			/************************************* Observers *****************************************/
+
+			hasher hash_function( void ) const {
+				return _table.getHasher();
+			}
+
+			key_equal key_eq( void ) const {
+				return _table.getEqual();
+			}
+
+			/************************************* Operations ****************************************/
+
+			iterator find( const key_type& k ) {
+				return _table.search( k );
+			}
+
+			const_iterator find( const key_type& k ) const {
+				return _table.search( k );
+			}
+
+			size_type count( const key_type& k ) const {
+				return find( k ) != end() ? 1 : 0;
+			}
+
+			pair<iterator,iterator> equal_range( const key_type& k ) {
+				iterator it = find( k );
+				if ( it == end() )
+					return ft::make_pair( it, it );
+				iterator next = it;
+				return ft::make_pair( it, ++next );
+			}
+
+			pair<const_iterator,const_iterator> equal_range( const key_type& k ) const {
+				const_iterator it = find( k );
+				if ( it == end() )
+					return ft::make_pair( it, it );
+				const_iterator next = it;
+				return ft::make_pair( it, ++next );
+			}
+
+			/************************************* Hash policy ***************************************/
+
+			// one slot per bucket
+			size_type bucket_count( void ) const {
+				return _table.getCapacity();
+			}
+
+			float load_factor( void ) const {
+				return size() ? static_cast< float >( size() ) / bucket_count() : 0;
+			}
+
+			// fixed: the table rehashes once 7/8 of the slots are taken
+			float max_load_factor( void ) const {
+				return 0.875f;
+			}
+
+			void rehash( size_type n ) {
+				_table.rehash( n );
+			}
+
+			void reserve( size_type n ) {
+				_table.reserve( n );
+			}
+
+			/************************************* Allocator *****************************************/
+
+			allocator_type get_allocator( void ) const {
+				return _allocator;
+			}
+
+	};
+
+}
+
+#endif
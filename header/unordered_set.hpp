@@ -0,0 +1,210 @@
+#ifndef UNORDERED_SET_HPP
+#define UNORDERED_SET_HPP
+
+#include "hash_table.hpp"
+
+namespace ft {
+
+	/*
+	** Set without order on the same hash table as ft::unordered_map.
+	** Inserts may rehash and invalidate every iterator, erases only
+	** invalidate the erased one.
+	*/
+	template < class T, class Hash = ft::hash<T>, class Pred = std::equal_to<T>, class Alloc = std::allocator<T> >
+	class unordered_set {
+
+		public:
+
+			/************************************* Typedefs ******************************************/
+
+			typedef T																					key_type;
+			typedef Hash																				hasher;
+			typedef Pred																				key_equal;
+			typedef T																					value_type;
+			typedef Alloc																				allocator_type;
+			typedef typename allocator_type::reference													reference;
+			typedef typename allocator_type::const_reference											const_reference;
+			typedef typename allocator_type::pointer													pointer;
+			typedef typename allocator_type::const_pointer												const_pointer;
+			typedef ft::hash_table< value_type, key_type, hash_identity, hasher, key_equal, allocator_type >	table_type;
+			typedef typename table_type::const_iterator													iterator;
+			typedef typename table_type::const_iterator													const_iterator;
+			typedef std::ptrdiff_t																		difference_type;
+			typedef size_t																				size_type;
+
+		private:
+
+			allocator_type _allocator;
+			table_type _table;
+
+		public:
+
+			/************************************* Constructors **************************************/
+
+			explicit unordered_set( size_type n = 0, const hasher& hf = hasher(), const key_equal& eql = key_equal(), const allocator_type& alloc = allocator_type() )
+			: _allocator( alloc ), _table( hf, eql, alloc ) {
+				_table.reserve( n );
+			}
+
+			template <class InputIterator>
+			unordered_set( InputIterator first, InputIterator last, size_type n = 0, const hasher& hf = hasher(), const key_equal& eql = key_equal(), const allocator_type& alloc = allocator_type() )
+			: _allocator( alloc ), _table( hf, eql, alloc ) {
+				_table.reserve( n );
+				insert( first, last );
+			}
+
+			unordered_set( const unordered_set& x ) : _allocator( x._allocator ), _table( x._table ) {}
+
+			/************************************* Destructor ****************************************/
+
+			~unordered_set( void ) {}
+
+			/************************************* Operator = ****************************************/
+
+			unordered_set& operator=( const unordered_set& x ) {
+				_table = x._table;
+				_allocator = x._allocator;
+				return *this;
+			}
+
+			/************************************* Iterators *****************************************/
+
+			const_iterator begin( void ) const {
+				return _table.begin();
+			}
+
+			const_iterator end( void ) const {
+				return _table.end();
+			}
+
+			/************************************* Capacity ******************************************/
+
+			bool empty( void ) const {
+				return ( _table.getSize() == 0 ) ? true : false;
+			}
+
+			size_type size( void ) const {
+				return _table.getSize();
+			}
+
+			size_type max_size( void ) const {
+				return _table.getAllocator().max_size();
+			}
+
+			/************************************* Modifiers *****************************************/
+
+			pair<iterator, bool> insert( const value_type& val ) {
+				bool duplicate = false;
+				iterator it = _table.add( val, &duplicate );
+				return ft::make_pair<iterator, bool>( it, !duplicate );
+			}
+
+			// the position does not help a hash table
+			iterator insert( const_iterator, const value_type& val ) {
+				return insert( val ).first;
+			}
+
+			template <class InputIterator>
+			void insert( InputIterator first, InputIterator last ) {
+				while ( first != last ) {
+					insert( *first );
+					first++;
+				}
+			}
+
+			// returns the iterator to the next element, the others stay valid
+			iterator erase( const_iterator position ) {
+				typename table_type::iterator it( position.getCtrl(), position.getSlot() );
+				_table.del( it++ );
+				return it;
+			}
+
+			size_type erase( const key_type& k ) {
+				typename table_type::iterator it = _table.search( k );
+				if ( it == _table.end() )
+					return 0;
+				_table.del( it );
+				return 1;
+			}
+
+			iterator erase( const_iterator first, const_iterator last ) {
+				typename table_type::iterator it( last.getCtrl(), last.getSlot() );
+				_table.del_range( typename table_type::iterator( first.getCtrl(), first.getSlot() ), it );
+				return it;
+			}
+
+			void swap( unordered_set& x ) {
+				allocator_type a = _allocator;
+				_allocator = x._allocator;
+				x._allocator = a;
+				_table.swap( x._table );
+			}
+
+			// destroys the values but keeps the slots
+			void clear( void ) {
+				_table.clear();
+			}
+
+			/************************************* Observers *****************************************/
+
+			hasher hash_function( void ) const {
+				return _table.getHasher();
+			}
+
+			key_equal key_eq( void ) const {
+				return _table.getEqual();
+			}
+
+			/************************************* Operations ****************************************/
+
+			const_iterator find( const key_type& k ) const {
+				return _table.search( k );
+			}
+
+			size_type count( const key_type& k ) const {
+				return find( k ) != end() ? 1 : 0;
+			}
+
+			pair<const_iterator,const_iterator> equal_range( const key_type& k ) const {
+				const_iterator it = find( k );
+				if ( it == end() )
+					return ft::make_pair( it, it );
+				const_iterator next = it;
+				return ft::make_pair( it, ++next );
+			}
+
+			/************************************* Hash policy ***************************************/
+
+			// one slot per bucket
+			size_type bucket_count( void ) const {
+				return _table.getCapacity();
+			}
+
+			float load_factor( void ) const {
+				return size() ? static_cast< float >( size() ) / bucket_count() : 0;
+			}
+
+			// fixed: the table rehashes once 7/8 of the slots are taken
+			float max_load_factor( void ) const {
+				return 0.875f;
+			}
+
+			void rehash( size_type n ) {
+				_table.rehash( n );
+			}
+
+			void reserve( size_type n ) {
+				_table.reserve( n );
+			}
+
+			/************************************* Allocator *****************************************/
+
+			allocator_type get_allocator( void ) const {
+				return _allocator;
+			}
+
+	};
+
+}
+
+#endif
@@ -1,10 +1,30 @@
 #ifndef UTILITY_HPP
 #define UTILITY_HPP
 
+#include <functional>
 #include "iterator.hpp"
 
 namespace ft {
 
+	template <class T = void>
+	struct less : std::binary_function<T, T, bool> {
+		bool operator()( const T& x, const T& y ) const {
+			return x < y;
+		}
+	};
+
+	// Transparent: orders any two types that have an operator<, so lookups in
+	// a map or set can use another key type than the stored one.
+	template <>
+	struct less<void> {
+		typedef void	is_transparent;
+
+		template <class T, class U>
+		bool operator()( const T& x, const U& y ) const {
+			return x < y;
+		}
+	};
+
 	template <class It>
 	typename It::difference_type 
     vector_do_distance( It first, It last ) {
@@ -44,6 +64,29 @@ namespace ft {
 		}
 		return first2 != last2;
 	}
+
+	// Stable sort of [first, last), buffer has room for as many elements.
+	template <class T, class Compare>
+	void merge_sort( T* first, T* last, T* buffer, Compare comp ) {
+		if ( last - first < 2 )
+			return ;
+		T* mid = first + ( last - first ) / 2;
+		merge_sort( first, mid, buffer, comp );
+		merge_sort( mid, last, buffer, comp );
+		if ( !comp( *mid, *( mid - 1 ) ) )
+			return ;
+		T* a = first;
+		T* b = mid;
+		T* out = buffer;
+		while ( a != mid && b != last )
+			*out++ = comp( *b, *a ) ? *b++ : *a++;
+		while ( a != mid )
+			*out++ = *a++;
+		while ( b != last )
+			*out++ = *b++;
+		for ( T* it = buffer; it != out; )
+			*first++ = *it++;
+	}
 	
 }
 
@@ -0,0 +1,864 @@
+#include <iostream>
+#include <cstdlib>
+#include <sys/time.h>
+
+#ifdef STL_CONTAINERS
+	#include <vector>
+	#include <map>
+	#include <set>
+	#if __cplusplus >= 201103L || defined( _LIBCPP_VERSION )
+		#include <unordered_map>
+		#define HASH_BENCH
+	#endif
+	namespace ft = std;
+#else
+	#include "vector.hpp"
+	#include "map.hpp"
+	#include "set.hpp"
+	#include "multimap.hpp"
+	#include "btree_set.hpp"
+	#include "flat_map.hpp"
+	#include "unordered_map.hpp"
+	#include "concurrent_map.hpp"
+	#include "persistent_map.hpp"
+	#include "interval_map.hpp"
+	#include <pthread.h>
+	#define HASH_BENCH
+	#include "pool_allocator.hpp"
+#endif
+
+long	getMicro( void ) {
+	struct timeval timer;
+
+	gettimeofday( &timer, NULL );
+	return ( timer.tv_sec * 1000000 ) + timer.tv_usec;
+}
+
+void	printResult( std::string test, size_t size, long elapsed, size_t ops ) {
+	std::cout << test << "\tsize = " << size << "\t" << elapsed / 1000 << " ms\t";
+	std::cout << ( elapsed * 1000.0 ) / ops << " ns/op" << std::endl;
+}
+
+void	lookupBench( void ) {
+	size_t lookups = 1000000;
+
+	std::cout << "LOOKUP BENCH (" << lookups << " random find/count per size):" << std::endl;
+	for ( size_t size = 1 << 10; size <= ( 1 << 22 ); size <<= 2 ) {
+		ft::set<int> a;
+		for ( size_t i = 0; i < size; i++ )
+			a.insert( i );
+		std::srand( 42 );
+		size_t found = 0;
+		long before = getMicro();
+		for ( size_t i = 0; i < lookups; i++ ) {
+			int key = std::rand() % ( size * 2 );
+			if ( a.find( key ) != a.end() )
+				found++;
+			found += a.count( key );
+		}
+		printResult( "set::find+count", size, getMicro() - before, lookups );
+		if ( found == 0 )
+			std::cout << "nothing found" << std::endl;
+	}
+	std::cout << std::endl;
+}
+
+void	insertBench( void ) {
+	size_t size = 4000000;
+
+	std::cout << "INSERT BENCH:" << std::endl;
+	{
+		ft::set<int> a;
+		long before = getMicro();
+		for ( size_t i = 0; i < size; i++ )
+			a.insert( i );
+		printResult( "set::insert sorted", size, getMicro() - before, size );
+	}
+	{
+		ft::set<int> a;
+		long before = getMicro();
+		for ( size_t i = size; i > 0; i-- )
+			a.insert( i );
+		printResult( "set::insert reverse", size, getMicro() - before, size );
+	}
+	{
+		ft::set<int> a;
+		std::srand( 42 );
+		long before = getMicro();
+		for ( size_t i = 0; i < size; i++ )
+			a.insert( std::rand() );
+		printResult( "set::insert random", size, getMicro() - before, size );
+	}
+	std::cout << std::endl;
+}
+
+// builds from ordered streams, the hint is where each key goes
+void	hintBench( void ) {
+	size_t size = 10000000;
+
+	std::cout << "HINT BENCH:" << std::endl;
+	{
+		ft::map<int, int> a;
+		long before = getMicro();
+		for ( size_t i = 0; i < size; i++ )
+			a.insert( ft::make_pair( static_cast< int >( i ), 0 ) );
+		printResult( "map::insert sorted", size, getMicro() - before, size );
+	}
+	{
+		ft::map<int, int> a;
+		long before = getMicro();
+		for ( size_t i = 0; i < size; i++ )
+			a.insert( a.end(), ft::make_pair( static_cast< int >( i ), 0 ) );
+		printResult( "map::insert( end() ) sorted", size, getMicro() - before, size );
+	}
+	{
+		ft::map<int, int> a;
+		long before = getMicro();
+		for ( size_t i = size; i > 0; i-- )
+			a.insert( a.begin(), ft::make_pair( static_cast< int >( i ), 0 ) );
+		printResult( "map::insert( begin() ) reverse", size, getMicro() - before, size );
+	}
+	{
+		ft::set<int> a;
+		ft::set<int>::iterator hint = a.end();
+		long before = getMicro();
+		for ( size_t i = 0; i < size; i++ )
+			hint = a.insert( hint, i );
+		printResult( "set::insert( previous ) sorted", size, getMicro() - before, size );
+	}
+	std::cout << std::endl;
+}
+
+template <class Map>
+void	churnMap( std::string test ) {
+	size_t live = 1000000;
+	size_t rounds = 1000000;
+	Map a;
+
+	std::srand( 42 );
+	long before = getMicro();
+	for ( size_t i = 0; i < live; i++ )
+		a[std::rand() % ( live * 4 )] = i;
+	for ( size_t i = 0; i < rounds; i++ ) {
+		a.erase( std::rand() % ( live * 4 ) );
+		a[std::rand() % ( live * 4 )] = i;
+	}
+	a.clear();
+	printResult( test, live, getMicro() - before, live + rounds * 2 );
+}
+
+void	allocatorBench( void ) {
+	std::cout << "ALLOCATOR BENCH (map<int, int> insert/erase churn):" << std::endl;
+	churnMap< ft::map<int, int> >( "std::allocator" );
+#ifndef STL_CONTAINERS
+	churnMap< ft::map<int, int, std::less<int>, ft::pool_allocator< ft::pair<const int, int> > > >( "ft::pool_allocator" );
+#endif
+	std::cout << std::endl;
+}
+
+void	copyBench( void ) {
+	size_t size = 4000000;
+	ft::map<int, int> a;
+
+	std::cout << "COPY BENCH:" << std::endl;
+	std::srand( 42 );
+	for ( size_t i = 0; i < size; i++ )
+		a[std::rand()] = i;
+	{
+		long before = getMicro();
+		ft::map<int, int> b( a );
+		printResult( "map copy constructor", b.size(), getMicro() - before, b.size() );
+	}
+	{
+		ft::map<int, int> b;
+		b[0] = 0;
+		long before = getMicro();
+		b = a;
+		printResult( "map::operator=", b.size(), getMicro() - before, b.size() );
+	}
+	std::cout << std::endl;
+}
+
+void	rangeBench( void ) {
+	size_t size = 4000000;
+	ft::vector< ft::pair<int, int> > sorted;
+	ft::vector< ft::pair<int, int> > shuffled;
+
+	std::cout << "RANGE CONSTRUCTOR BENCH:" << std::endl;
+	std::srand( 42 );
+	for ( size_t i = 0; i < size; i++ ) {
+		sorted.push_back( ft::make_pair( i, i ) );
+		shuffled.push_back( ft::make_pair( std::rand(), i ) );
+	}
+	{
+		long before = getMicro();
+		ft::map<int, int> a( sorted.begin(), sorted.end() );
+		printResult( "map range sorted", a.size(), getMicro() - before, size );
+	}
+	{
+		long before = getMicro();
+		ft::map<int, int> a( shuffled.begin(), shuffled.end() );
+		printResult( "map range random", a.size(), getMicro() - before, size );
+	}
+	std::cout << std::endl;
+}
+
+void	eraseBench( void ) {
+	size_t size = 50000;
+	ft::map< std::string, ft::vector<int> > a;
+	ft::vector<std::string> keys;
+
+	std::cout << "ERASE BENCH (map<std::string, vector<int> >):" << std::endl;
+	std::srand( 42 );
+	for ( size_t i = 0; i < size; i++ ) {
+		std::string key( 24, 'a' );
+		for ( size_t j = 0; j < key.size(); j++ )
+			key[j] += std::rand() % 26;
+		keys.push_back( key );
+		a[key] = ft::vector<int>( 256, i );
+	}
+	for ( size_t i = keys.size(); i > 1; i-- ) {
+		size_t j = std::rand() % i;
+		std::string tmp = keys[i - 1];
+		keys[i - 1] = keys[j];
+		keys[j] = tmp;
+	}
+	long before = getMicro();
+	for ( size_t i = 0; i < keys.size(); i++ )
+		a.erase( keys[i] );
+	printResult( "map::erase random", size, getMicro() - before, size );
+	std::cout << std::endl;
+}
+
+void	subscriptBench( void ) {
+	size_t size = 100000;
+	size_t lookups = 4000000;
+	ft::map<int, std::string> a;
+
+	std::cout << "SUBSCRIPT BENCH (" << lookups << " operator[] hits):" << std::endl;
+	for ( size_t i = 0; i < size; i++ )
+		a[i] = "a value that does not fit in the small string buffer";
+	std::srand( 42 );
+	size_t total = 0;
+	long before = getMicro();
+	for ( size_t i = 0; i < lookups; i++ )
+		total += a[std::rand() % size].size();
+	printResult( "map::operator[] hit", size, getMicro() - before, lookups );
+	if ( total == 0 )
+		std::cout << "nothing found" << std::endl;
+	std::cout << std::endl;
+}
+
+void	rangeEraseBench( void ) {
+	size_t size = 4000000;
+	size_t window = 1000000;
+	ft::map<int, int> a;
+
+	std::cout << "RANGE ERASE BENCH:" << std::endl;
+	for ( size_t i = 0; i < size; i++ )
+		a[i] = i;
+	long before = getMicro();
+	a.erase( a.find( size / 2 ), a.find( size / 2 + window ) );
+	printResult( "map::erase window", size, getMicro() - before, window );
+	before = getMicro();
+	for ( size_t i = 0; i < 100000; i++ ) {
+		ft::map<int, int>::iterator first = a.lower_bound( i * 11 );
+		ft::map<int, int>::iterator last = first;
+		for ( size_t j = 0; j < 3 && last != a.end(); j++ )
+			last++;
+		a.erase( first, last );
+	}
+	printResult( "map::erase 3 elements", a.size(), getMicro() - before, 100000 );
+	std::cout << std::endl;
+}
+
+void	stringLookupBench( void ) {
+	size_t size = 100000;
+	size_t lookups = 1000000;
+#ifdef STL_CONTAINERS
+	ft::map<std::string, int> a;
+#else
+	ft::map<std::string, int, ft::less<> > a;
+#endif
+	ft::vector<std::string> keys;
+
+	std::cout << "STRING LOOKUP BENCH (" << lookups << " find by const char*):" << std::endl;
+	std::srand( 42 );
+	for ( size_t i = 0; i < size; i++ ) {
+		std::string key( 32, 'a' );
+		for ( size_t j = 0; j < key.size(); j++ )
+			key[j] += std::rand() % 26;
+		keys.push_back( key );
+		a[key] = i;
+	}
+	size_t found = 0;
+	long before = getMicro();
+	for ( size_t i = 0; i < lookups; i++ )
+		found += a.find( keys[std::rand() % size].c_str() ) != a.end();
+	printResult( "map::find const char*", size, getMicro() - before, lookups );
+	if ( found == 0 )
+		std::cout << "nothing found" << std::endl;
+	std::cout << std::endl;
+}
+
+void	fillSet( ft::set<int>& a, size_t size, int step ) {
+	for ( size_t i = 0; i < size; i++ )
+		a.insert( i * step );
+}
+
+void	algebraBench( size_t big, size_t small ) {
+	ft::set<int> a, b, c, d;
+	fillSet( a, big, 3 );
+	fillSet( b, small, 7 );
+	fillSet( c, big, 3 );
+	fillSet( d, small, 7 );
+	long before = getMicro();
+#ifdef STL_CONTAINERS
+	a.insert( b.begin(), b.end() );
+	for ( ft::set<int>::iterator it = d.begin(); it != d.end(); it++ )
+		c.erase( *it );
+#else
+	a.set_union( b );
+	c.set_difference( d );
+#endif
+	printResult( "set union+difference", big, getMicro() - before, small * 2 );
+}
+
+void	setAlgebraBench( void ) {
+	std::cout << "SET ALGEBRA BENCH (1M element set with a smaller one):" << std::endl;
+	algebraBench( 1000000, 1000 );
+	algebraBench( 1000000, 100000 );
+	algebraBench( 1000000, 1000000 );
+	std::cout << std::endl;
+}
+
+// the map of vectors the multimap replaces
+void	multiBench( void ) {
+	size_t size = 1000000;
+	size_t keys = 100000;
+	std::cout << "MULTI BENCH (map of vectors vs multimap, " << size / keys << " values per key):" << std::endl;
+
+	long before = getMicro();
+	{
+		ft::map<int, ft::vector<int> > a;
+		std::srand( 42 );
+		for ( size_t i = 0; i < size; i++ )
+			a[std::rand() % keys].push_back( i );
+		printResult( "map<vector>::insert", size, getMicro() - before, size );
+		long sum = 0;
+		before = getMicro();
+		for ( size_t i = 0; i < keys; i++ ) {
+			ft::map<int, ft::vector<int> >::iterator it = a.find( std::rand() % keys );
+			if ( it != a.end() )
+				for ( size_t j = 0; j < it->second.size(); j++ )
+					sum += it->second[j];
+		}
+		printResult( "map<vector>::find+scan", size, getMicro() - before, keys );
+		if ( sum == 0 )
+			std::cout << "nothing found" << std::endl;
+	}
+	before = getMicro();
+	{
+		ft::multimap<int, int> a;
+		std::srand( 42 );
+		for ( size_t i = 0; i < size; i++ )
+			a.insert( ft::make_pair( static_cast< int >( std::rand() % keys ), static_cast< int >( i ) ) );
+		printResult( "multimap::insert", size, getMicro() - before, size );
+		long sum = 0;
+		before = getMicro();
+		for ( size_t i = 0; i < keys; i++ ) {
+			ft::pair<ft::multimap<int, int>::iterator, ft::multimap<int, int>::iterator> range = a.equal_range( std::rand() % keys );
+			for ( ; range.first != range.second; range.first++ )
+				sum += range.first->second;
+		}
+		printResult( "multimap::equal_range+scan", size, getMicro() - before, keys );
+		if ( sum == 0 )
+			std::cout << "nothing found" << std::endl;
+	}
+	std::cout << std::endl;
+}
+
+#ifndef STL_CONTAINERS
+void	orderStatisticsBench( void ) {
+	size_t size = 1000000;
+	size_t queries = 1000000;
+	ft::set<int, std::less<int>, std::allocator<int>, ft::ranked_nodes> a;
+
+	std::cout << "ORDER STATISTICS BENCH (ranked set, " << queries << " random nth+rank):" << std::endl;
+	std::srand( 42 );
+	long before = getMicro();
+	for ( size_t i = 0; i < size; i++ )
+		a.insert( std::rand() );
+	printResult( "ranked set::insert random", a.size(), getMicro() - before, size );
+	size_t sum = 0;
+	before = getMicro();
+	for ( size_t i = 0; i < queries; i++ ) {
+		sum += *a.nth( std::rand() % a.size() ) & 1;
+		sum += a.rank( std::rand() );
+	}
+	printResult( "ranked set::nth+rank", a.size(), getMicro() - before, queries );
+	if ( sum == 0 )
+		std::cout << "nothing ranked" << std::endl;
+	std::cout << std::endl;
+}
+
+template <class S>
+void	searchTreeBench( std::string name, size_t size ) {
+	size_t queries = 1000000;
+	S a;
+
+	std::srand( 42 );
+	long before = getMicro();
+	for ( size_t i = 0; i < size; i++ )
+		a.insert( std::rand() % ( size * 2 ) );
+	printResult( name + "::insert random", a.size(), getMicro() - before, size );
+	size_t found = 0;
+	before = getMicro();
+	for ( size_t i = 0; i < queries; i++ )
+		found += a.count( std::rand() % ( size * 2 ) );
+	printResult( name + "::count random", a.size(), getMicro() - before, queries );
+	long sum = 0;
+	before = getMicro();
+	for ( typename S::iterator it = a.begin(); it != a.end(); it++ )
+		sum += *it;
+	printResult( name + "::iterate", a.size(), getMicro() - before, a.size() );
+	before = getMicro();
+	for ( size_t i = 0; i < queries; i++ )
+		found += a.erase( std::rand() % ( size * 2 ) );
+	printResult( name + "::erase random", a.size(), getMicro() - before, queries );
+	if ( found == 0 || sum == 0 )
+		std::cout << "nothing found" << std::endl;
+}
+
+void	btreeBench( void ) {
+	std::cout << "BTREE BENCH (red-black set vs btree_set, int keys):" << std::endl;
+	for ( size_t size = 1000000; size <= 10000000; size *= 10 ) {
+		searchTreeBench< ft::set<int> >( "set", size );
+		searchTreeBench< ft::btree_set<int> >( "btree_set", size );
+	}
+	std::cout << std::endl;
+}
+
+template <class M>
+void	readMostlyBench( std::string name, const ft::vector< ft::pair<int, int> >& data ) {
+	size_t queries = 2000000;
+
+	long before = getMicro();
+	M a( data.begin(), data.end() );
+	printResult( name + "::range insert", a.size(), getMicro() - before, data.size() );
+	std::srand( 42 );
+	size_t found = 0;
+	before = getMicro();
+	for ( size_t i = 0; i < queries; i++ )
+		found += a.count( std::rand() % ( data.size() * 2 ) );
+	printResult( name + "::count random", a.size(), getMicro() - before, queries );
+	long sum = 0;
+	before = getMicro();
+	for ( typename M::iterator it = a.begin(); it != a.end(); it++ )
+		sum += it->second;
+	printResult( name + "::iterate", a.size(), getMicro() - before, a.size() );
+	if ( found == 0 || sum == 0 )
+		std::cout << "nothing found" << std::endl;
+}
+
+void	flatBench( void ) {
+	std::cout << "FLAT BENCH (red-black map vs flat_map, built once then read):" << std::endl;
+	for ( size_t size = 10000; size <= 1000000; size *= 10 ) {
+		ft::vector< ft::pair<int, int> > data;
+		std::srand( 7 );
+		for ( size_t i = 0; i < size; i++ )
+			data.push_back( ft::make_pair( static_cast< int >( std::rand() % ( size * 2 ) ), 1 ) );
+		readMostlyBench< ft::map<int, int> >( "map", data );
+		readMostlyBench< ft::flat_map<int, int> >( "flat_map", data );
+	}
+	std::cout << std::endl;
+}
+// the baseline for concurrent_map: one ft::map behind one mutex
+class	lockedMap {
+
+	public:
+
+		lockedMap( size_t ) {
+			pthread_mutex_init( &_lock, NULL );
+		}
+
+		~lockedMap( void ) {
+			pthread_mutex_destroy( &_lock );
+		}
+
+		bool	find( int key, int* value ) {
+			pthread_mutex_lock( &_lock );
+			ft::map<int, int>::iterator it = _map.find( key );
+			bool found = ( it != _map.end() );
+			if ( found )
+				*value = it->second;
+			pthread_mutex_unlock( &_lock );
+			return found;
+		}
+
+		bool	insert_or_assign( int key, int value ) {
+			pthread_mutex_lock( &_lock );
+			bool inserted = _map.insert_or_assign( key, value ).second;
+			pthread_mutex_unlock( &_lock );
+			return inserted;
+		}
+
+	private:
+
+		pthread_mutex_t _lock;
+		ft::map<int, int> _map;
+
+};
+
+template <class M>
+struct	sharedWork {
+	M* map;
+	size_t ops;
+	size_t range;
+	unsigned seed;
+	size_t found;
+};
+
+// nine finds for one write, keys drawn with a per thread generator
+template <class M>
+void*	sharedMix( void* arg ) {
+	sharedWork<M>* work = static_cast< sharedWork<M>* >( arg );
+	unsigned seed = work->seed;
+	int value;
+
+	for ( size_t i = 0; i < work->ops; i++ ) {
+		seed = seed * 1103515245 + 12345;
+		int key = ( seed >> 8 ) % work->range;
+		if ( i % 10 == 9 )
+			work->map->insert_or_assign( key, i );
+		else
+			work->found += work->map->find( key, &value );
+	}
+	return NULL;
+}
+
+template <class M>
+void	sharedBench( std::string name, size_t threads, size_t range ) {
+	size_t ops = 2000000;
+	M a( 64 );
+	ft::vector< sharedWork<M> > work( threads );
+	ft::vector< pthread_t > ids( threads );
+
+	for ( size_t i = 0; i < range; i += 2 )
+		a.insert_or_assign( i, i );
+	for ( size_t i = 0; i < threads; i++ ) {
+		work[i].map = &a;
+		work[i].ops = ops / threads;
+		work[i].range = range;
+		work[i].seed = i + 1;
+		work[i].found = 0;
+	}
+	long before = getMicro();
+	for ( size_t i = 0; i < threads; i++ )
+		pthread_create( &ids[i], NULL, sharedMix<M>, &work[i] );
+	for ( size_t i = 0; i < threads; i++ )
+		pthread_join( ids[i], NULL );
+	long elapsed = getMicro() - before;
+	std::cout << threads << " threads\t";
+	printResult( name, range / 2, elapsed, ops );
+}
+
+void	concurrentBench( void ) {
+	size_t range = 200000;
+
+	std::cout << "CONCURRENT BENCH (one mutex vs 64 reader-writer locked shards, 90% find):" << std::endl;
+	for ( size_t threads = 1; threads <= 64; threads *= 2 ) {
+		sharedBench< lockedMap >( "locked map", threads, range );
+		sharedBench< ft::concurrent_map<int, int> >( "concurrent_map", threads, range );
+	}
+	{
+		ft::concurrent_map<int, int> a;
+		ft::vector<int> keys;
+		ft::vector<int> values( range );
+		bool* found = new bool[range];
+		for ( size_t i = 0; i < range; i++ ) {
+			a.insert_or_assign( i, i );
+			keys.push_back( std::rand() % range );
+		}
+		int value;
+		size_t hits = 0;
+		long before = getMicro();
+		for ( size_t i = 0; i < range; i++ )
+			hits += a.find( keys[i], &value );
+		printResult( "concurrent_map::find", range, getMicro() - before, range );
+		before = getMicro();
+		hits += a.find_batch( &keys[0], range, &values[0], found );
+		printResult( "concurrent_map::find_batch", range, getMicro() - before, range );
+		delete[] found;
+		if ( hits == 0 )
+			std::cout << "nothing found" << std::endl;
+	}
+	std::cout << std::endl;
+}
+template <class M>
+void	snapshotBench( std::string name, size_t size ) {
+	size_t updates = 100000;
+	size_t interval = 1000;
+	size_t copies = 10000000 / size;
+	M a;
+
+	std::srand( 42 );
+	for ( size_t i = 0; i < size; i++ )
+		a.insert_or_assign( std::rand() % ( size * 2 ), i );
+	long before = getMicro();
+	for ( size_t i = 0; i < copies; i++ ) {
+		M copy( a );
+		if ( copy.size() != a.size() )
+			std::cout << "bad copy" << std::endl;
+	}
+	printResult( name + "::copy", a.size(), getMicro() - before, copies );
+	// a copy of the current version is kept every interval writes
+	M version( a );
+	size_t found = 0;
+	before = getMicro();
+	for ( size_t i = 0; i < updates; i++ ) {
+		a.insert_or_assign( std::rand() % ( size * 2 ), i );
+		if ( i % interval == 0 )
+			version = a;
+	}
+	printResult( name + "::insert_or_assign", a.size(), getMicro() - before, updates );
+	before = getMicro();
+	for ( size_t i = 0; i < updates; i++ )
+		found += a.count( std::rand() % ( size * 2 ) );
+	printResult( name + "::count random", a.size(), getMicro() - before, updates );
+	if ( found == 0 || version.empty() )
+		std::cout << "nothing found" << std::endl;
+}
+
+void	persistentBench( void ) {
+	std::cout << "PERSISTENT BENCH (map copied vs persistent_map snapshots, a version copied every 1000 writes):" << std::endl;
+	for ( size_t size = 10000; size <= 1000000; size *= 10 ) {
+		snapshotBench< ft::map<int, int> >( "map", size );
+		snapshotBench< ft::persistent_map<int, int> >( "persistent_map", size );
+	}
+	std::cout << std::endl;
+}
+
+// random keys inserted in random order, so the nodes are spread over the heap
+void	batchLookupBench( void ) {
+	size_t lookups = 1 << 21;
+	size_t batches[] = { 64, 256, 512 };
+	std::string names[] = { "map::find_batch 64", "map::find_batch 256", "map::find_batch 512" };
+
+	std::cout << "BATCH LOOKUP BENCH (" << lookups << " random keys, find one by one vs find_batch):" << std::endl;
+	for ( size_t size = 1 << 16; size <= ( 1 << 24 ); size <<= 4 ) {
+		ft::map<int, int> a;
+		std::srand( 42 );
+		for ( size_t i = 0; i < size; i++ )
+			a.insert( ft::make_pair( std::rand() % static_cast< int >( size * 2 ), 0 ) );
+		ft::vector<int> keys( lookups );
+		for ( size_t i = 0; i < lookups; i++ )
+			keys[i] = std::rand() % static_cast< int >( size * 2 );
+		ft::vector< ft::map<int, int>::iterator > out( lookups );
+		size_t found = 0;
+		long before = getMicro();
+		for ( size_t i = 0; i < lookups; i++ )
+			out[i] = a.find( keys[i] );
+		printResult( "map::find", a.size(), getMicro() - before, lookups );
+		for ( size_t b = 0; b < sizeof( batches ) / sizeof( *batches ); b++ ) {
+			before = getMicro();
+			for ( size_t i = 0; i < lookups; i += batches[b] )
+				a.find_batch( &keys[i], batches[b], &out[i] );
+			printResult( names[b], a.size(), getMicro() - before, lookups );
+		}
+		for ( size_t i = 0; i < lookups; i++ )
+			found += ( out[i] != a.end() );
+		if ( found == 0 )
+			std::cout << "nothing found" << std::endl;
+	}
+	std::cout << std::endl;
+}
+
+// m sorted keys against a map of 1M: a loop of find pays log n per key, find_sorted log( n / m )
+void	sortedLookupBench( void ) {
+	size_t size = 1 << 20;
+	ft::map<int, int> a;
+
+	std::cout << "SORTED LOOKUP BENCH (sorted keys against a map of " << size << ", find one by one vs find_sorted):" << std::endl;
+	for ( size_t i = 0; i < size; i++ )
+		a.insert( ft::make_pair( static_cast< int >( i * 2 ), 0 ) );
+	for ( size_t probes = 1 << 10; probes <= size; probes <<= 5 ) {
+		size_t rounds = ( 1 << 22 ) / probes;
+		size_t step = size * 2 / probes;
+		ft::vector<int> keys( probes );
+		for ( size_t i = 0; i < probes; i++ )
+			keys[i] = static_cast< int >( i * step + i % 2 );
+		ft::vector< ft::map<int, int>::iterator > out( probes );
+		long before = getMicro();
+		for ( size_t r = 0; r < rounds; r++ )
+			for ( size_t i = 0; i < probes; i++ )
+				out[i] = a.find( keys[i] );
+		printResult( "map::find", probes, getMicro() - before, rounds * probes );
+		before = getMicro();
+		for ( size_t r = 0; r < rounds; r++ )
+			a.find_sorted( keys.begin(), keys.end(), out.begin() );
+		printResult( "map::find_sorted", probes, getMicro() - before, rounds * probes );
+		if ( out[0] == a.end() )
+			std::cout << "nothing found" << std::endl;
+	}
+	std::cout << std::endl;
+}
+
+struct	valueSum {
+	typedef long result_type;
+	static result_type identity( void ) { return 0; }
+	static result_type lift( const ft::pair<const int, int>& v ) { return v.second; }
+	static result_type combine( result_type a, result_type b ) { return a + b; }
+};
+
+// sums over random key ranges of up to 10000 keys: iterator walk vs cached subtree sums
+void	aggregateBench( void ) {
+	typedef ft::map<int, int, std::less<int>, std::allocator< ft::pair<const int, int> >, ft::aggregate_nodes<valueSum> > sum_map;
+	size_t queries = 100000;
+
+	std::cout << "AGGREGATE BENCH (" << queries << " range sums of up to 10000 keys):" << std::endl;
+	for ( size_t size = 1 << 16; size <= ( 1 << 22 ); size <<= 3 ) {
+		sum_map a;
+		std::srand( 42 );
+		for ( size_t i = 0; i < size; i++ )
+			a.insert( ft::make_pair( static_cast< int >( i ), std::rand() % 1000 ) );
+		long walked = 0;
+		long summed = 0;
+		std::srand( 43 );
+		long before = getMicro();
+		for ( size_t i = 0; i < queries; i++ ) {
+			int lo = std::rand() % static_cast< int >( size );
+			sum_map::const_iterator last = a.lower_bound( lo + std::rand() % 10000 );
+			for ( sum_map::const_iterator it = a.lower_bound( lo ); it != last; ++it )
+				walked += it->second;
+		}
+		printResult( "map walk", size, getMicro() - before, queries );
+		std::srand( 43 );
+		before = getMicro();
+		for ( size_t i = 0; i < queries; i++ ) {
+			int lo = std::rand() % static_cast< int >( size );
+			summed += a.aggregate( lo, lo + std::rand() % 10000 );
+		}
+		printResult( "map::aggregate", size, getMicro() - before, queries );
+		if ( walked != summed )
+			std::cout << "different sums" << std::endl;
+	}
+	std::cout << std::endl;
+}
+
+// short random intervals, a few matches per query: a map keyed by start scanned up to the query end vs interval_map
+void	intervalBench( void ) {
+	std::cout << "INTERVAL BENCH (overlap queries, map keyed by start scanned vs interval_map::overlapping):" << std::endl;
+	for ( size_t size = 1 << 14; size <= ( 1 << 20 ); size <<= 3 ) {
+		int range = static_cast< int >( size * 16 );
+		ft::map<int, int> starts;
+		ft::interval_map<int, int> intervals;
+		std::srand( 42 );
+		for ( size_t i = 0; i < size; i++ ) {
+			int lo = std::rand() % range;
+			int hi = lo + 1 + std::rand() % 64;
+			starts.insert( ft::make_pair( lo, hi ) );
+			intervals.insert( lo, hi, 0 );
+		}
+		size_t scans = ( 1 << 25 ) / size;
+		size_t queries = 1000000;
+		size_t scanned = 0;
+		size_t found = 0;
+		long before = getMicro();
+		for ( size_t i = 0; i < scans; i++ ) {
+			int lo = std::rand() % range;
+			for ( ft::map<int, int>::iterator it = starts.begin(); it != starts.end() && it->first < lo + 16; ++it )
+				scanned += ( lo < it->second );
+		}
+		printResult( "map scan", size, getMicro() - before, scans );
+		before = getMicro();
+		for ( size_t i = 0; i < queries; i++ ) {
+			int lo = std::rand() % range;
+			ft::pair< ft::interval_map<int, int>::query_iterator, ft::interval_map<int, int>::query_iterator > r = intervals.overlapping( lo, lo + 16 );
+			for ( ; r.first != r.second; ++r.first )
+				found++;
+		}
+		printResult( "interval_map::overlapping", size, getMicro() - before, queries );
+		std::cout << "\t" << static_cast< double >( found ) / queries << " intervals per query" << std::endl;
+		if ( scanned == 0 )
+			std::cout << "nothing found" << std::endl;
+	}
+	std::cout << std::endl;
+}
+#endif
+
+#ifdef HASH_BENCH
+// keys are even, odd keys are misses
+template <class M>
+void	hashMixBench( std::string name, size_t size ) {
+	size_t queries = 2000000;
+	ft::vector<int> keys;
+	M a;
+
+	std::srand( 42 );
+	for ( size_t i = 0; i < size; i++ )
+		keys.push_back( ( std::rand() % ( size * 4 ) ) * 2 );
+	long before = getMicro();
+	for ( size_t i = 0; i < size; i++ )
+		a[keys[i]] = i;
+	printResult( name + "::insert random", a.size(), getMicro() - before, size );
+	size_t found = 0;
+	before = getMicro();
+	for ( size_t i = 0; i < queries; i++ )
+		found += a.count( keys[std::rand() % size] );
+	printResult( name + "::count hit", a.size(), getMicro() - before, queries );
+	before = getMicro();
+	for ( size_t i = 0; i < queries; i++ )
+		found += a.count( keys[std::rand() % size] + 1 );
+	printResult( name + "::count miss", a.size(), getMicro() - before, queries );
+	before = getMicro();
+	for ( size_t i = 0; i < queries; i++ ) {
+		size_t j = std::rand() % size;
+		found += a.erase( keys[j] );
+		keys[j] = ( std::rand() % ( size * 4 ) ) * 2;
+		a[keys[j]] = i;
+	}
+	printResult( name + "::erase+insert", a.size(), getMicro() - before, queries );
+	if ( found == 0 )
+		std::cout << "nothing found" << std::endl;
+}
+
+void	hashBench( void ) {
+	std::cout << "HASH BENCH (map vs unordered_map, int keys):" << std::endl;
+	for ( size_t size = 10000; size <= 1000000; size *= 10 ) {
+		hashMixBench< ft::map<int, int> >( "map", size );
+		hashMixBench< ft::unordered_map<int, int> >( "unordered_map", size );
+	}
+	std::cout << std::endl;
+}
+#endif
+
+int	main( void ) {
+	lookupBench();
+	insertBench();
+	hintBench();
+	allocatorBench();
+	copyBench();
+	rangeBench();
+	setAlgebraBench();
+	eraseBench();
+	stringLookupBench();
+	subscriptBench();
+	rangeEraseBench();
+	multiBench();
+#ifndef STL_CONTAINERS
+	orderStatisticsBench();
+	btreeBench();
+	flatBench();
+	concurrentBench();
+	persistentBench();
+	batchLookupBench();
+	sortedLookupBench();
+	aggregateBench();
+	intervalBench();
+#endif
+#ifdef HASH_BENCH
+	hashBench();
+#endif
+	return (0);
+}
@@ -15,6 +15,19 @@
 	#include "stack.hpp"
 	#include "map.hpp"
 	#include "set.hpp"
+	#include "multimap.hpp"
+	#include "multiset.hpp"
+	#include "btree_map.hpp"
+	#include "btree_set.hpp"
+	#include "flat_map.hpp"
+	#include "flat_set.hpp"
+	#include "unordered_map.hpp"
+	#include "unordered_set.hpp"
+	#include "concurrent_map.hpp"
+	#include "persistent_map.hpp"
+	#include "interval_map.hpp"
+	#include "pool_allocator.hpp"
+	#include <pthread.h>
 #endif
 
 template<typename T>
@@ -1544,6 +1557,67 @@ void mapConstructorTests( void ) {
 		fifth['a']=10;
 		displayMap( fifth, "Constructor test 5" );
 	}
+	{
+		ft::map<int,int> first;
+		for ( int i = 0; i < 200; i++ )
+			first[i * 7 % 211] = i;
+		for ( int i = 0; i < 200; i += 3 )
+			first.erase( i * 7 % 211 );
+		ft::map<int,int> second( first );
+		ft::map<int,int> third;
+		third[-1] = -1;
+		third = second;
+		third = third;
+		first.erase( first.begin() );
+		first[500] = 500;
+		third[1000] = 1000;
+		third.erase( --third.end() );
+		third.erase( third.begin() );
+		std::cout << first.size() << " " << second.size() << " " << third.size() << std::endl;
+		std::cout << second.begin()->first << " " << ( --second.end() )->first << std::endl;
+		for ( ft::map<int,int>::reverse_iterator it = third.rbegin(); it != third.rend(); it++ )
+			std::cout << it->first << ":" << it->second << " ";
+		std::cout << std::endl;
+		ft::map<int,int> empty;
+		third = empty;
+		std::cout << third.size() << " " << ( third.begin() == third.end() ) << std::endl;
+	}
+	{
+		ft::vector< ft::pair<int,int> > sorted;
+		for ( int i = 0; i < 1000; i++ )
+			sorted.push_back( ft::make_pair( i * 2, i ) );
+		ft::map<int,int> first( sorted.begin(), sorted.end() );
+		for ( int i = 0; i < 2000; i += 3 )
+			first.erase( i );
+		for ( int i = 1; i < 300; i += 2 )
+			first[i] = -i;
+		ft::vector< ft::pair<int,int> > unsorted;
+		for ( int i = 0; i < 100; i++ )
+			unsorted.push_back( ft::make_pair( i * 37 % 50, i ) );
+		ft::map<int,int> second( unsorted.begin(), unsorted.end() );
+		ft::map<int,int> third( sorted.begin(), sorted.begin() );
+		ft::map<int,int> fourth( sorted.begin(), sorted.begin() + 1 );
+		std::cout << first.size() << " " << second.size() << " " << third.size() << " " << fourth.size() << std::endl;
+		std::cout << first.begin()->first << " " << first.rbegin()->first << " " << first[151] << std::endl;
+		for ( ft::map<int,int>::iterator it = second.begin(); it != second.end(); it++ )
+			std::cout << it->first << ":" << it->second << " ";
+		std::cout << std::endl;
+		long sum = 0;
+		for ( ft::map<int,int>::reverse_iterator it = first.rbegin(); it != first.rend(); it++ )
+			sum += it->first * it->second;
+		std::cout << sum << std::endl;
+		// a sorted head, then values that land before, inside and on it
+		ft::vector< ft::pair<int,int> > head( sorted.begin(), sorted.begin() + 20 );
+		head.push_back( ft::make_pair( 7, 70 ) );
+		head.push_back( ft::make_pair( -1, 10 ) );
+		head.push_back( ft::make_pair( 4, 40 ) );
+		head.push_back( ft::make_pair( 100, 1 ) );
+		ft::map<int,int> fifth( head.begin(), head.end() );
+		std::cout << fifth.size() << ":";
+		for ( ft::map<int,int>::iterator it = fifth.begin(); it != fifth.end(); it++ )
+			std::cout << " " << it->first << "=" << it->second;
+		std::cout << std::endl;
+	}
 }
 
 void mapIteratorTests( void ) {
@@ -1597,6 +1671,31 @@ void mapCapacityTests( void ) {
 	}
 }
 
+#ifdef STL_CONTAINERS
+	template <class M>
+	std::pair<typename M::iterator, bool> mapTryEmplace( M& m, const typename M::key_type& k, const typename M::mapped_type& obj ) {
+		return m.insert( std::make_pair( k, obj ) );
+	}
+
+	template <class M>
+	std::pair<typename M::iterator, bool> mapInsertOrAssign( M& m, const typename M::key_type& k, const typename M::mapped_type& obj ) {
+		std::pair<typename M::iterator, bool> res = m.insert( std::make_pair( k, obj ) );
+		if ( !res.second )
+			res.first->second = obj;
+		return res;
+	}
+#else
+	template <class M>
+	ft::pair<typename M::iterator, bool> mapTryEmplace( M& m, const typename M::key_type& k, const typename M::mapped_type& obj ) {
+		return m.try_emplace( k, obj );
+	}
+
+	template <class M>
+	ft::pair<typename M::iterator, bool> mapInsertOrAssign( M& m, const typename M::key_type& k, const typename M::mapped_type& obj ) {
+		return m.insert_or_assign( k, obj );
+	}
+#endif
+
 void mapElementAccessTests( void ) {
 	std::cout << "MAP ELEMENT ACCESS TESTS:" << std::endl << std::endl;
 
@@ -1629,6 +1728,22 @@ void mapElementAccessTests( void ) {
 		std::cout << a["hi"] << std::endl;
 		std::cout << a["wtf"] << std::endl;
 	}
+	{
+		ft::map<std::string, std::string> a;
+		ft::pair<ft::map<std::string, std::string>::iterator, bool> res;
+		res = mapTryEmplace( a, "one", std::string( "1" ) );
+		std::cout << res.first->first << res.first->second << res.second << " ";
+		res = mapTryEmplace( a, "one", std::string( "uno" ) );
+		std::cout << res.first->first << res.first->second << res.second << " ";
+		res = mapInsertOrAssign( a, "two", std::string( "2" ) );
+		std::cout << res.first->first << res.first->second << res.second << " ";
+		res = mapInsertOrAssign( a, "two", std::string( "dos" ) );
+		std::cout << res.first->first << res.first->second << res.second << std::endl;
+		for ( int i = 0; i < 20; i++ )
+			a[std::string( 1, 'a' + i * 7 % 20 )] += "x";
+		a["b"] += "y";
+		std::cout << a.size() << " " << a["b"] << " " << a["one"] << " " << a["zzz"] << " " << a.size() << std::endl;
+	}
 }
 
 void mapModifiersTests( void ) {
@@ -1684,6 +1799,17 @@ void mapModifiersTests( void ) {
 		b.insert( a.begin(), a.end() );
 		displayMap( b, "Insert test 7.5" );
 	}
+	{
+		ft::map<int, int> a;
+		for ( int i = 0; i < 1000; i++ )
+			a.insert( a.end(), ft::make_pair( i * 2, i ) );
+		for ( int i = 0; i < 1000; i++ )
+			a.insert( a.begin(), ft::make_pair( -i, i ) );
+		ft::map<int, int>::iterator it = a.insert( a.find( 500 ), ft::make_pair( 501, 1 ) );
+		std::cout << a.size() << " " << a.begin()->first << " " << a.rbegin()->first << " " << it->first << " " << ( ++it )->first << std::endl;
+		it = a.insert( a.find( 600 ), ft::make_pair( 600, 7 ) );
+		std::cout << it->second << " " << a.insert( a.end(), ft::make_pair( 0, 7 ) )->second << " " << a.size() << std::endl;
+	}
 	{
 		ft::map<int, int> a;
 		ft::map<int, int> b;
@@ -1872,6 +1998,47 @@ void mapModifiersTests( void ) {
 		std::cout << std::boolalpha << a.value_comp()( p1, p2 ) << std::endl;
 		std::cout << std::boolalpha << a.value_comp()( p3, p4 ) << std::endl;
 	}
+	{
+		ft::map<int, std::string> a;
+		ft::vector< ft::map<int, std::string>::iterator > its;
+		for ( int i = 0; i < 64; i++ )
+			its.push_back( a.insert( ft::make_pair( i * 5 % 64, std::string( 1, 'a' + i % 26 ) ) ).first );
+		for ( int i = 0; i < 64; i += 2 )
+			a.erase( its[i] );
+		for ( int i = 1; i < 64; i += 2 )
+			std::cout << its[i]->first << its[i]->second << " ";
+		std::cout << std::endl;
+		ft::map<int, std::string>::iterator it = a.begin();
+		while ( it != a.end() ) {
+			ft::map<int, std::string>::iterator next = it;
+			next++;
+			if ( it->first % 3 == 0 )
+				a.erase( it );
+			it = next;
+		}
+		displayMap( a, "Erase iterators test" );
+	}
+	{
+		ft::map<int, int> a;
+		for ( int i = 0; i < 1000; i++ )
+			a[i * 17 % 1000] = i;
+		a.erase( a.find( 100 ), a.find( 200 ) );
+		a.erase( a.begin(), a.find( 10 ) );
+		a.erase( a.find( 990 ), a.end() );
+		a.erase( a.find( 500 ), a.find( 500 ) );
+		a.erase( a.find( 501 ), ++a.find( 501 ) );
+		std::cout << a.size() << " " << a.begin()->first << " " << a.rbegin()->first << std::endl;
+		long sum = 0;
+		for ( ft::map<int, int>::iterator it = a.begin(); it != a.end(); it++ )
+			sum += it->first * 3 + it->second;
+		std::cout << sum << " " << a.count( 99 ) << a.count( 100 ) << a.count( 199 ) << a.count( 200 ) << std::endl;
+		for ( int i = 0; i < 10; i++ )
+			a[i] = i;
+		a.erase( a.begin(), a.end() );
+		std::cout << a.size() << " " << ( a.begin() == a.end() ) << std::endl;
+		a[1] = 1;
+		displayMap( a, "Range erase test" );
+	}
 }
 
 void mapOperationsTests( void ) {
@@ -1976,6 +2143,29 @@ void mapOperationsTests( void ) {
 		p = a.equal_range( -100 );
 		std::cout << p.first->first << " " << p.second->first << std::endl;
 	}
+	{
+		#ifdef STL_CONTAINERS
+			typedef std::map<std::string, int> transparent_map;
+			typedef std::set<std::string> transparent_set;
+		#else
+			typedef ft::map<std::string, int, ft::less<> > transparent_map;
+			typedef ft::set<std::string, ft::less<> > transparent_set;
+		#endif
+		transparent_map a;
+		transparent_set b;
+		const char* words[] = { "pear", "apple", "fig", "plum", "kiwi", "lime", "date" };
+		for ( int i = 0; i < 7; i++ ) {
+			a[words[i]] = i;
+			b.insert( words[i] );
+		}
+		std::cout << a.find( "fig" )->second << " " << ( a.find( "grape" ) == a.end() ) << " ";
+		std::cout << a.count( "kiwi" ) << " " << a.count( "melon" ) << " ";
+		std::cout << a.lower_bound( "g" )->first << " " << a.upper_bound( "lime" )->first << " ";
+		std::cout << a.equal_range( "date" ).first->first << " " << a.equal_range( "date" ).second->first << std::endl;
+		std::cout << *b.find( "plum" ) << " " << b.count( "apple" ) << " " << *b.lower_bound( "b" ) << " " << ( b.upper_bound( "plum" ) == b.end() ) << std::endl;
+		const transparent_map& c = a;
+		std::cout << c.find( "pear" )->second << " " << ( c.lower_bound( "z" ) == c.end() ) << std::endl;
+	}
 }
 
 void setConstructorTests( void ) {
@@ -2010,6 +2200,33 @@ void setConstructorTests( void ) {
 		first.insert( 'a' );
 		displaySet( fifth, "Constructor test 5" );
 	}
+	{
+		ft::set<std::string> first;
+		for ( char c = 'a'; c <= 'z'; c++ )
+			first.insert( std::string( 3, c ) );
+		ft::set<std::string> second;
+		second = first;
+		first.erase( "mmm" );
+		second.insert( "zzzz" );
+		ft::set<std::string> third( second );
+		third.erase( third.begin() );
+		std::cout << first.size() << " " << second.size() << " " << third.size() << std::endl;
+		for ( ft::set<std::string>::iterator it = third.begin(); it != third.end(); it++ )
+			std::cout << *it << " ";
+		std::cout << std::endl;
+	}
+	{
+		ft::set<int> first;
+		for ( int i = 0; i < 777; i++ )
+			first.insert( i * 5 );
+		ft::set<int, std::greater<int> > second( first.rbegin(), first.rend() );
+		ft::set<int> third( second.begin(), second.end() );
+		for ( int i = 0; i < 4000; i += 7 ) {
+			second.erase( i );
+			third.insert( i );
+		}
+		std::cout << second.size() << " " << third.size() << " " << *second.begin() << " " << *third.rbegin() << std::endl;
+	}
 }
 
 void setIteratorTests( void ) {
@@ -2303,6 +2520,15 @@ void setModifiersTests( void ) {
 		std::cout << std::boolalpha << d.value_comp()( f, h ) << std::endl;
 		std::cout << std::boolalpha << d.value_comp()( z, a ) << std::endl;
 	}
+	{
+		ft::set<std::string> a;
+		for ( int i = 0; i < 300; i++ )
+			a.insert( std::string( 1, 'a' + i % 26 ) + std::string( 1, 'a' + i / 26 ) );
+		a.erase( a.lower_bound( "c" ), a.lower_bound( "p" ) );
+		a.erase( --a.end(), a.end() );
+		a.erase( a.begin(), ++a.begin() );
+		std::cout << a.size() << " " << *a.begin() << " " << *a.rbegin() << " " << *a.lower_bound( "c" ) << std::endl;
+	}
 }
 
 void setOperationsTests( void ) {
@@ -2407,6 +2633,1056 @@ void setOperationsTests( void ) {
 	}
 }
 
+void poolAllocatorTests( void ) {
+	std::cout << "POOL ALLOCATOR TESTS:" << std::endl << std::endl;
+
+	#ifdef STL_CONTAINERS
+		typedef std::allocator< std::pair<const int, std::string> > map_alloc;
+		typedef std::allocator<long> set_alloc;
+	#else
+		typedef ft::pool_allocator< ft::pair<const int, std::string> > map_alloc;
+		typedef ft::pool_allocator<long> set_alloc;
+	#endif
+	{
+		typedef ft::map<int, std::string, std::less<int>, map_alloc > pool_map;
+		pool_map a;
+		for ( int i = 0; i < 1000; i++ )
+			a[i % 100 * 7] = "value";
+		for ( int i = 0; i < 700; i += 2 )
+			a.erase( i );
+		for ( int i = 0; i < 50; i++ )
+			a.insert( ft::make_pair( i * 3, std::string( "again" ) ) );
+		pool_map b( a );
+		a.clear();
+		a[42] = "after clear";
+		a.swap( b );
+		std::cout << a.size() << " " << b.size() << " " << b[42] << std::endl;
+		for ( pool_map::iterator it = a.begin(); it != a.end(); it++ )
+			std::cout << it->first << " " << it->second << " | ";
+		std::cout << std::endl;
+		std::cout << ( a.get_allocator() == a.get_allocator() ) << std::endl;
+	}
+	{
+		ft::set<long, std::greater<long>, set_alloc > a;
+		for ( long i = 0; i < 100000; i++ )
+			a.insert( i * 31 % 100003 );
+		for ( long i = 0; i < 100000; i += 3 )
+			a.erase( i * 31 % 100003 );
+		long sum = 0;
+		for ( ft::set<long, std::greater<long>, set_alloc >::iterator it = a.begin(); it != a.end(); it++ )
+			sum += *it;
+		std::cout << a.size() << " " << *a.begin() << " " << sum << std::endl;
+		a.clear();
+		std::cout << a.size() << std::endl;
+	}
+	std::cout << "=======================================================" << std::endl;
+}
+
+#ifdef STL_CONTAINERS
+	template <class M>
+	typename M::iterator containerNth( M& m, size_t n ) {
+		typename M::iterator it = m.begin();
+		std::advance( it, n < m.size() ? n : m.size() );
+		return it;
+	}
+
+	template <class M>
+	size_t containerRank( M& m, typename M::key_type k ) {
+		return std::distance( m.begin(), m.lower_bound( k ) );
+	}
+
+	template <class M>
+	long containerDistance( M&, typename M::const_iterator first, typename M::const_iterator last ) {
+		return std::distance( first, last );
+	}
+#else
+	template <class M>
+	typename M::iterator containerNth( M& m, size_t n ) {
+		return m.nth( n );
+	}
+
+	template <class M>
+	size_t containerRank( M& m, typename M::key_type k ) {
+		return m.rank( k );
+	}
+
+	template <class M>
+	long containerDistance( M& m, typename M::const_iterator first, typename M::const_iterator last ) {
+		return m.distance( first, last );
+	}
+#endif
+
+template <class M>
+void orderStatistics( M& m, int range ) {
+	for ( size_t n = 0; n <= m.size(); n += 37 ) {
+		typename M::iterator it = containerNth( m, n );
+		if ( it != m.end() )
+			std::cout << n << ":" << it->first << " ";
+	}
+	std::cout << ( containerNth( m, m.size() ) == m.end() ) << std::endl;
+	for ( int k = -5; k < range + 5; k += 41 )
+		std::cout << containerRank( m, k ) << " ";
+	std::cout << std::endl;
+	typename M::const_iterator first = m.lower_bound( range / 4 );
+	typename M::const_iterator last = m.upper_bound( range / 2 );
+	std::cout << containerDistance( m, first, last ) << " ";
+	std::cout << containerDistance( m, m.begin(), m.end() ) << " ";
+	std::cout << containerDistance( m, last, last ) << std::endl;
+}
+
+void orderStatisticsTests( void ) {
+	std::cout << "ORDER STATISTICS TESTS:" << std::endl << std::endl;
+
+	#ifdef STL_CONTAINERS
+		typedef std::map<int, int> ranked_map;
+		typedef std::set<int> ranked_set;
+	#else
+		typedef ft::map<int, int, std::less<int>, std::allocator< ft::pair<const int, int> >, ft::ranked_nodes > ranked_map;
+		typedef ft::set<int, std::less<int>, std::allocator<int>, ft::ranked_nodes > ranked_set;
+	#endif
+	{
+		ranked_map a;
+		ft::map<int, int> b;
+		for ( int i = 0; i < 3000; i++ ) {
+			a[i * 7 % 2003] = i;
+			b[i * 7 % 2003] = i;
+		}
+		for ( int i = 0; i < 2003; i += 3 ) {
+			a.erase( i );
+			b.erase( i );
+		}
+		a.erase( a.begin() );
+		b.erase( b.begin() );
+		orderStatistics( a, 2003 );
+		orderStatistics( b, 2003 );
+		ranked_map c( a );
+		c.insert( ft::make_pair( 5000, 0 ) );
+		ranked_map d;
+		d = c;
+		d.swap( a );
+		orderStatistics( a, 5000 );
+		orderStatistics( d, 5000 );
+		a.clear();
+		orderStatistics( a, 10 );
+	}
+	{
+		ft::vector< ft::pair<int, int> > sorted;
+		for ( int i = 0; i < 500; i++ )
+			sorted.push_back( ft::make_pair( i * 3, i ) );
+		ranked_map a( sorted.begin(), sorted.end() );
+		orderStatistics( a, 1500 );
+		ranked_set b;
+		for ( int i = 0; i < 100; i++ )
+			b.insert( i * i % 101 );
+		#ifndef STL_CONTAINERS
+			std::cout << *b.nth( 10 ) << " " << b.rank( 50 ) << " " << b.distance( b.begin(), b.find( 64 ) ) << std::endl;
+		#else
+			ranked_set::iterator it = b.begin();
+			std::advance( it, 10 );
+			std::cout << *it << " " << std::distance( b.begin(), b.lower_bound( 50 ) ) << " " << std::distance( b.begin(), b.find( 64 ) ) << std::endl;
+		#endif
+	}
+	std::cout << "=======================================================" << std::endl;
+}
+
+template <class T>
+const T& keyOf( const T& value ) {
+	return value;
+}
+
+template <class K, class V>
+const K& keyOf( const ft::pair<K, V>& value ) {
+	return value.first;
+}
+
+#ifdef STL_CONTAINERS
+	template <class C>
+	void containerUnion( C& a, C& b ) {
+		a.insert( b.begin(), b.end() );
+		b.clear();
+	}
+
+	template <class C>
+	void containerIntersection( C& a, C& b ) {
+		for ( typename C::iterator it = a.begin(); it != a.end(); )
+			if ( b.count( keyOf( *it ) ) == 0 )
+				a.erase( it++ );
+			else
+				it++;
+		b.clear();
+	}
+
+	template <class C>
+	void containerDifference( C& a, C& b ) {
+		for ( typename C::iterator it = b.begin(); it != b.end(); it++ )
+			a.erase( keyOf( *it ) );
+		b.clear();
+	}
+#else
+	template <class C>
+	void containerUnion( C& a, C& b ) {
+		a.set_union( b );
+	}
+
+	template <class C>
+	void containerIntersection( C& a, C& b ) {
+		a.set_intersection( b );
+	}
+
+	template <class C>
+	void containerDifference( C& a, C& b ) {
+		a.set_difference( b );
+	}
+#endif
+
+template <class C>
+void displayAlgebra( C& a, C& b ) {
+	long sum = 0;
+	for ( typename C::iterator it = a.begin(); it != a.end(); it++ )
+		sum = sum * 31 % 1000003 + keyOf( *it );
+	std::cout << a.size() << " " << b.size() << " " << sum;
+	if ( !a.empty() )
+		std::cout << " " << keyOf( *a.begin() ) << " " << keyOf( *a.rbegin() );
+	std::cout << std::endl;
+}
+
+void setAlgebraTests( void ) {
+	std::cout << "SET ALGEBRA TESTS:" << std::endl << std::endl;
+
+	for ( int round = 0; round < 4; round++ ) {
+		int big = round * 3000 + 1;
+		int small = round * 40;
+		ft::set<int> a, b, c, d, e, f;
+		for ( int i = 0; i < big; i++ ) {
+			a.insert( i * 7 % 10007 );
+			c.insert( i * 7 % 10007 );
+			e.insert( i * 7 % 10007 );
+		}
+		for ( int i = 0; i < small; i++ ) {
+			b.insert( i * 131 % 10007 );
+			d.insert( i * 131 % 10007 );
+			f.insert( i * 131 % 10007 );
+		}
+		containerUnion( a, b );
+		displayAlgebra( a, b );
+		containerIntersection( c, d );
+		displayAlgebra( c, d );
+		containerDifference( e, f );
+		displayAlgebra( e, f );
+		containerUnion( b, a );
+		displayAlgebra( b, a );
+		b.insert( -1 );
+		b.erase( keyOf( *b.rbegin() ) );
+		displayAlgebra( b, a );
+	}
+	{
+		ft::map<int, std::string> a, b;
+		for ( int i = 0; i < 50; i++ ) {
+			a[i * 2] = "a";
+			b[i * 3] = "b";
+		}
+		ft::map<int, std::string> c( a ), d( b );
+		containerUnion( a, b );
+		for ( ft::map<int, std::string>::iterator it = a.begin(); it != a.end(); it++ )
+			std::cout << it->first << it->second << " ";
+		std::cout << std::endl;
+		containerDifference( d, c );
+		for ( ft::map<int, std::string>::iterator it = d.begin(); it != d.end(); it++ )
+			std::cout << it->first << it->second << " ";
+		std::cout << std::endl << c.size() << std::endl;
+	}
+	std::cout << "=======================================================" << std::endl;
+}
+
+void multiTests( void ) {
+	std::cout << "MULTI TESTS:" << std::endl << std::endl;
+	{
+		ft::multimap<int, std::string> a;
+		for ( int i = 0; i < 3000; i++ )
+			a.insert( ft::make_pair( i * 7 % 100, std::string( 1, 'a' + i % 26 ) ) );
+		a.insert( a.upper_bound( 42 ), ft::make_pair( 42, std::string( "last" ) ) );
+		a.insert( a.lower_bound( 42 ), ft::make_pair( 42, std::string( "first" ) ) );
+		a.insert( a.end(), ft::make_pair( 500, std::string( "end" ) ) );
+		std::cout << a.size() << " " << a.count( 42 ) << " " << a.count( 101 ) << " " << a.find( 42 )->second << std::endl;
+		ft::pair<ft::multimap<int, std::string>::iterator, ft::multimap<int, std::string>::iterator> range = a.equal_range( 42 );
+		for ( ft::multimap<int, std::string>::iterator it = range.first; it != range.second; it++ )
+			std::cout << it->second;
+		std::cout << std::endl;
+		std::cout << a.erase( 42 ) << " " << a.size() << " " << a.count( 42 ) << " " << ( a.find( 42 ) == a.end() ) << std::endl;
+		a.erase( a.lower_bound( 10 ), a.upper_bound( 60 ) );
+		std::cout << a.size() << " " << a.begin()->first << " " << a.rbegin()->second << " " << a.lower_bound( 10 )->first << std::endl;
+		ft::multimap<int, std::string> b( a.begin(), a.end() );
+		b.erase( b.begin() );
+		std::cout << a.size() << " " << b.size() << " " << ( b.begin()->second == a.begin()->second ) << std::endl;
+	}
+	{
+		ft::multiset<int> a;
+		for ( int i = 0; i < 2000; i++ )
+			a.insert( i % 37 );
+		const ft::multiset<int>& c = a;
+		std::cout << a.size() << " " << c.count( 5 ) << " " << c.count( 36 ) << " " << *c.upper_bound( 5 ) << " " << *c.rbegin() << std::endl;
+		a.erase( a.find( 5 ) );
+		std::cout << a.count( 5 ) << " " << a.erase( 6 ) << " " << a.size() << std::endl;
+	}
+	std::cout << "=======================================================" << std::endl;
+}
+
+void btreeTests( void ) {
+	std::cout << "BTREE TESTS:" << std::endl << std::endl;
+
+	#ifdef STL_CONTAINERS
+		typedef std::map<int, std::string> btree_map;
+		typedef std::set<int> btree_set;
+	#else
+		typedef ft::btree_map<int, std::string> btree_map;
+		typedef ft::btree_set<int> btree_set;
+	#endif
+	{
+		btree_map a;
+		for ( int i = 0; i < 5000; i++ )
+			a[i * 13 % 4999] = "v";
+		for ( int i = 0; i < 4999; i += 3 )
+			a.erase( i );
+		a.insert( ft::make_pair( 7000, std::string( "last" ) ) );
+		a.insert( a.end(), ft::make_pair( 8000, std::string( "hint" ) ) );
+		a.insert( a.begin(), ft::make_pair( -1, std::string( "first" ) ) );
+		std::cout << a.size() << " " << a.begin()->second << " " << a.rbegin()->second << std::endl;
+		long sum = 0;
+		for ( btree_map::iterator it = a.begin(); it != a.end(); it++ )
+			sum = ( sum * 31 + it->first ) % 1000003;
+		for ( btree_map::reverse_iterator it = a.rbegin(); it != a.rend(); it++ )
+			sum = ( sum * 7 + it->first ) % 1000003;
+		std::cout << sum << std::endl;
+		std::cout << a.lower_bound( 3 )->first << " " << a.upper_bound( 4 )->first << " ";
+		std::cout << a.count( 6 ) << " " << a.count( 7 ) << " " << ( a.find( 9 ) == a.end() ) << std::endl;
+		ft::pair<btree_map::iterator, btree_map::iterator> range = a.equal_range( 100 );
+		std::cout << range.first->first << " " << range.second->first << std::endl;
+		btree_map b( a );
+		b.erase( b.lower_bound( 1000 ), b.lower_bound( 3000 ) );
+		b.erase( b.begin() );
+		std::cout << a.size() << " " << b.size() << " " << b.begin()->first << std::endl;
+		b.swap( a );
+		std::cout << a.size() << " " << b.size() << std::endl;
+		a.erase( a.begin(), a.end() );
+		std::cout << a.empty() << " " << ( a.begin() == a.end() ) << " " << ( a.rbegin() == a.rend() ) << std::endl;
+		ft::vector< ft::pair<int, std::string> > pairs;
+		for ( int i = 0; i < 500; i++ )
+			pairs.push_back( ft::make_pair( i * 4, std::string( i % 2 ? "odd" : "even" ) ) );
+		pairs.push_back( ft::make_pair( 6, std::string( "late" ) ) );
+		a.insert( pairs.begin(), pairs.end() );
+		a.erase( a.lower_bound( 10 ), a.find( 400 ) );
+		std::cout << a.size() << " " << a.find( 6 )->second << " " << a.lower_bound( 7 )->first << " " << a.find( 404 )->second << std::endl;
+		const btree_map empty;
+		btree_set none;
+		std::cout << ( empty.rbegin() == empty.rend() ) << " " << ( none.rbegin() == none.rend() ) << std::endl;
+	}
+	{
+		ft::vector<int> sorted;
+		for ( int i = 0; i < 3000; i++ )
+			sorted.push_back( i * 2 );
+		btree_set a( sorted.begin(), sorted.end() );
+		const btree_set& c = a;
+		std::cout << a.size() << " " << *c.begin() << " " << *c.rbegin() << " " << *c.lower_bound( 1001 ) << std::endl;
+		for ( int i = 0; i < 6000; i += 3 )
+			a.erase( i );
+		std::cout << a.size() << " " << *a.begin() << " " << *a.upper_bound( 4000 ) << std::endl;
+		a.erase( a.lower_bound( 5000 ), a.end() );
+		a.erase( a.lower_bound( 100 ), a.lower_bound( 3100 ) );
+		std::cout << a.size() << " " << *a.lower_bound( 99 ) << " " << *a.rbegin() << std::endl;
+	}
+	std::cout << "=======================================================" << std::endl;
+}
+
+void flatTests( void ) {
+	std::cout << "FLAT TESTS:" << std::endl << std::endl;
+
+	#ifdef STL_CONTAINERS
+		typedef std::map<int, std::string> flat_map;
+		typedef std::set<int> flat_set;
+	#else
+		typedef ft::flat_map<int, std::string> flat_map;
+		typedef ft::flat_set<int> flat_set;
+	#endif
+	{
+		flat_map a;
+		for ( int i = 0; i < 2000; i++ )
+			a[i * 13 % 1999] = "v";
+		for ( int i = 0; i < 1999; i += 3 )
+			a.erase( i );
+		a.insert( ft::make_pair( 7000, std::string( "last" ) ) );
+		a.insert( a.end(), ft::make_pair( 8000, std::string( "hint" ) ) );
+		a.insert( a.begin(), ft::make_pair( -1, std::string( "first" ) ) );
+		std::cout << a.size() << " " << a.begin()->second << " " << a.rbegin()->second << std::endl;
+		long sum = 0;
+		for ( flat_map::iterator it = a.begin(); it != a.end(); it++ )
+			sum = ( sum * 31 + it->first ) % 1000003;
+		for ( flat_map::reverse_iterator it = a.rbegin(); it != a.rend(); it++ )
+			sum = ( sum * 7 + it->first ) % 1000003;
+		std::cout << sum << std::endl;
+		std::cout << a.lower_bound( 3 )->first << " " << a.upper_bound( 4 )->first << " ";
+		std::cout << a.count( 6 ) << " " << a.count( 7 ) << " " << ( a.find( 9 ) == a.end() ) << std::endl;
+		ft::pair<flat_map::iterator, flat_map::iterator> range = a.equal_range( 100 );
+		std::cout << range.first->first << " " << range.second->first << std::endl;
+		ft::vector< ft::pair<int, std::string> > more;
+		for ( int i = 3000; i > 1000; i -= 7 )
+			more.push_back( ft::make_pair( i, std::string( "bulk" ) ) );
+		flat_map b( a );
+		b.insert( more.begin(), more.end() );
+		b.erase( b.lower_bound( 1500 ), b.lower_bound( 2500 ) );
+		b.erase( b.begin() );
+		std::cout << a.size() << " " << b.size() << " " << b.begin()->first << " " << b[1001] << " " << b[2999] << std::endl;
+		b.swap( a );
+		std::cout << a.size() << " " << b.size() << std::endl;
+		a.erase( a.begin(), a.end() );
+		std::cout << a.empty() << " " << ( a.begin() == a.end() ) << std::endl;
+	}
+	{
+		ft::vector<int> values;
+		for ( int i = 0; i < 3000; i++ )
+			values.push_back( i * 7 % 3001 * 2 );
+		flat_set a( values.begin(), values.end() );
+		const flat_set& c = a;
+		std::cout << a.size() << " " << *c.begin() << " " << *c.rbegin() << " " << *c.lower_bound( 1001 ) << std::endl;
+		for ( int i = 0; i < 6000; i += 3 )
+			a.erase( i );
+		a.insert( values.begin(), values.begin() + 100 );
+		std::cout << a.size() << " " << *a.begin() << " " << *a.upper_bound( 4000 ) << std::endl;
+		// hinted inserts at end() build a sorted set from empty
+		flat_set b;
+		b.erase( b.begin(), b.end() );
+		for ( int i = 0; i < 50; i++ )
+			b.insert( b.end(), i * 3 );
+		b.insert( b.end(), 10 );
+		b.erase( b.find( 30 ) );
+		std::cout << b.size() << " " << *b.begin() << " " << *b.rbegin() << " " << ( b.find( 30 ) == b.end() ) << std::endl;
+		b.erase( b.begin(), b.end() );
+		b.insert( b.end(), 5 );
+		std::cout << b.size() << " " << *b.begin() << std::endl;
+	}
+	std::cout << "=======================================================" << std::endl;
+}
+
+void unorderedTests( void ) {
+	std::cout << "UNORDERED TESTS:" << std::endl << std::endl;
+
+	// iteration order is unspecified: only sizes, lookups and sums are printed
+	#ifdef STL_CONTAINERS
+		typedef std::map<int, std::string> unordered_map;
+		typedef std::set<int> unordered_set;
+	#else
+		typedef ft::unordered_map<int, std::string> unordered_map;
+		typedef ft::unordered_set<int> unordered_set;
+	#endif
+	{
+		unordered_map a;
+		for ( int i = 0; i < 5000; i++ )
+			a[i * 13 % 4999] = "v";
+		for ( int i = 0; i < 4999; i += 3 )
+			a.erase( i );
+		a.insert( ft::make_pair( 7000, std::string( "last" ) ) );
+		std::cout << a.size() << " " << a.find( 7000 )->second << " " << a.insert( ft::make_pair( 7000, std::string( "again" ) ) ).second << std::endl;
+		long sum = 0;
+		for ( unordered_map::iterator it = a.begin(); it != a.end(); it++ )
+			sum += it->first;
+		std::cout << sum << std::endl;
+		std::cout << a.count( 6 ) << " " << a.count( 7 ) << " " << ( a.find( 9 ) == a.end() ) << std::endl;
+		for ( unordered_map::iterator it = a.begin(); it != a.end(); ) {
+			if ( it->first % 2 )
+				a.erase( it++ );
+			else
+				it++;
+		}
+		unordered_map b( a );
+		b[1] = "one";
+		b.erase( 7000 );
+		std::cout << a.size() << " " << b.size() << " " << b[1] << " " << a.count( 1 ) << std::endl;
+		b.swap( a );
+		std::cout << a.size() << " " << b.size() << std::endl;
+		a.erase( a.begin(), a.end() );
+		std::cout << a.empty() << " " << ( a.begin() == a.end() ) << std::endl;
+	}
+	{
+		ft::vector<int> values;
+		for ( int i = 0; i < 3000; i++ )
+			values.push_back( i * 7 % 3001 * 2 );
+		unordered_set a( values.begin(), values.end() );
+		const unordered_set& c = a;
+		std::cout << a.size() << " " << c.count( 1000 ) << " " << c.count( 1001 ) << std::endl;
+		for ( int i = 0; i < 6000; i += 3 )
+			a.erase( i );
+		long sum = 0;
+		for ( unordered_set::const_iterator it = c.begin(); it != c.end(); it++ )
+			sum += *it;
+		std::cout << a.size() << " " << sum << std::endl;
+	}
+	std::cout << "=======================================================" << std::endl;
+}
+
+#ifndef STL_CONTAINERS
+	struct concurrentWork {
+		ft::concurrent_map<int, int>* map;
+		int first;
+		int last;
+	};
+
+	void addHundred( int& value ) {
+		value += 100;
+	}
+
+	// each thread fills its own range, then bumps and erases part of it
+	void* concurrentFill( void* arg ) {
+		concurrentWork* work = static_cast< concurrentWork* >( arg );
+		for ( int i = work->first; i < work->last; i++ )
+			work->map->insert( ft::make_pair( i, i ) );
+		for ( int i = work->first; i < work->last; i += 2 )
+			work->map->update( i, addHundred );
+		for ( int i = work->first; i < work->last; i += 5 )
+			work->map->erase( i );
+		return NULL;
+	}
+#endif
+
+bool boundLess( int lhs, int rhs ) {
+	return lhs < rhs;
+}
+
+void concurrentTests( void ) {
+	std::cout << "CONCURRENT TESTS:" << std::endl << std::endl;
+
+	// std has no concurrent map: the STL build runs the same work on one thread
+	int keys[] = { 3, 4, 10, 999, 1000, 2001, 3999, 4000, -1 };
+	int values[9];
+	bool found[9];
+	#ifndef STL_CONTAINERS
+		ft::concurrent_map<int, int> a( 6 );
+		concurrentWork work[4];
+		pthread_t ids[4];
+		for ( int i = 0; i < 4; i++ ) {
+			work[i].map = &a;
+			work[i].first = i * 1000;
+			work[i].last = ( i + 1 ) * 1000;
+			pthread_create( &ids[i], NULL, concurrentFill, &work[i] );
+		}
+		for ( int i = 0; i < 4; i++ )
+			pthread_join( ids[i], NULL );
+		std::cout << a.shard_count() << " " << a.size() << " " << a.count( 5 ) << " " << a.count( 7 ) << std::endl;
+		std::cout << a.find_batch( keys, 9, values, found ) << std::endl;
+		for ( int i = 0; i < 9; i++ )
+			std::cout << found[i] << ":" << ( found[i] ? values[i] : 0 ) << " ";
+		std::cout << std::endl;
+		std::cout << a.insert( ft::make_pair( 3, 0 ) ) << " " << a.insert_or_assign( 3, 33 ) << " " << a.insert_or_assign( 4000, 1 ) << std::endl;
+		std::cout << a.erase_batch( keys, 9 ) << " " << a.erase_batch( keys, 9 ) << " " << a.size() << std::endl;
+		ft::pair<int, int> more[] = { ft::make_pair( 3, 1 ), ft::make_pair( 3, 2 ), ft::make_pair( 8000, 3 ), ft::make_pair( 1, 4 ) };
+		std::cout << a.insert_batch( more, 4 ) << " " << a.find( 3, values ) << " " << values[0] << " " << a.find( 5000, values ) << std::endl;
+		a.clear();
+		std::cout << a.empty() << " " << a.update( 3, addHundred ) << std::endl;
+		// every shard gets the function pointer comparator
+		ft::concurrent_map< int, int, ft::hash<int>, bool (*)( int, int ) > b( 4, ft::hash<int>(), boundLess );
+		for ( int i = 0; i < 100; i++ )
+			b.insert( ft::make_pair( i * 7 % 101, i ) );
+		std::cout << b.size() << " " << b.find( 49, values ) << " " << values[0] << std::endl;
+	#else
+		std::map<int, int> a;
+		for ( int i = 0; i < 4000; i++ )
+			a[i] = i + ( i % 2 ? 0 : 100 );
+		for ( int i = 0; i < 4000; i += 5 )
+			a.erase( i );
+		std::cout << 8 << " " << a.size() << " " << a.count( 5 ) << " " << a.count( 7 ) << std::endl;
+		size_t n = 0;
+		for ( int i = 0; i < 9; i++ ) {
+			found[i] = a.count( keys[i] );
+			values[i] = found[i] ? a[keys[i]] : 0;
+			n += found[i];
+		}
+		std::cout << n << std::endl;
+		for ( int i = 0; i < 9; i++ )
+			std::cout << found[i] << ":" << values[i] << " ";
+		std::cout << std::endl;
+		bool inserted = a.insert( std::make_pair( 3, 0 ) ).second;
+		a[3] = 33;
+		std::cout << inserted << " " << false << " " << a.insert( std::make_pair( 4000, 1 ) ).second << std::endl;
+		n = 0;
+		for ( int i = 0; i < 9; i++ )
+			n += a.erase( keys[i] );
+		std::cout << n << " " << 0 << " " << a.size() << std::endl;
+		std::pair<int, int> more[] = { std::make_pair( 3, 1 ), std::make_pair( 3, 2 ), std::make_pair( 8000, 3 ), std::make_pair( 1, 4 ) };
+		size_t before = a.size();
+		a.insert( more, more + 4 );
+		std::cout << a.size() - before << " " << ( a.count( 3 ) == 1 ) << " " << a[3] << " " << ( a.count( 5000 ) == 1 ) << std::endl;
+		a.clear();
+		std::cout << a.empty() << " " << false << std::endl;
+		std::map< int, int, bool (*)( int, int ) > b( boundLess );
+		for ( int i = 0; i < 100; i++ )
+			b.insert( std::make_pair( i * 7 % 101, i ) );
+		std::cout << b.size() << " " << ( b.count( 49 ) == 1 ) << " " << b[49] << std::endl;
+	#endif
+	std::cout << "=======================================================" << std::endl;
+}
+
+template <class M>
+void persistentStatus( const M& m ) {
+	long sum = 0;
+	for ( typename M::const_iterator it = m.begin(); it != m.end(); it++ )
+		sum += it->first * 3 + it->second;
+	std::cout << m.size() << " " << sum;
+	if ( !m.empty() )
+		std::cout << " " << m.begin()->first << " " << m.rbegin()->first;
+	std::cout << std::endl;
+}
+
+void persistentTests( void ) {
+	std::cout << "PERSISTENT MAP TESTS:" << std::endl << std::endl;
+
+	#ifdef STL_CONTAINERS
+		typedef std::map<int, int> persistent_map;
+	#else
+		typedef ft::persistent_map<int, int> persistent_map;
+	#endif
+	{
+		persistent_map a;
+		for ( int i = 0; i < 1000; i++ )
+			a.insert( ft::make_pair( i * 37 % 1000, i ) );
+		persistent_map b( a );
+		for ( int i = 0; i < 1000; i += 2 )
+			a.erase( i );
+		std::cout << a.insert( ft::make_pair( 5000, 1 ) ).second << " " << a.insert( ft::make_pair( 5000, 2 ) ).second << std::endl;
+		persistent_map c;
+		c = a;
+		a.erase( 5000 );
+		a.erase( 1 );
+		a.erase( a.find( 999 ) );
+		#ifndef STL_CONTAINERS
+			a.erase( a.find( 999 ) );
+		#endif
+		persistentStatus( a );
+		persistentStatus( b );
+		persistentStatus( c );
+		std::cout << a.lower_bound( 500 )->first << " " << a.upper_bound( 501 )->first << " " << a.count( 3 ) << " " << b.count( 4 ) << std::endl;
+		persistent_map::const_iterator added = a.insert( ft::make_pair( 7000, 3 ) ).first;
+		std::cout << added->first << " " << added->second << " " << ( ++added == a.end() ) << std::endl;
+		b.clear();
+		persistentStatus( b );
+		persistentStatus( c );
+		persistent_map::const_reverse_iterator it = c.rbegin();
+		for ( int i = 0; i < 5; i++ )
+			std::cout << ( it++ )->first << " ";
+		std::cout << std::endl;
+		b.swap( c );
+		persistentStatus( b );
+		persistentStatus( c );
+	}
+	std::cout << "=======================================================" << std::endl;
+}
+
+template <class M>
+void displayKeys( const M& m ) {
+	for ( typename M::const_iterator it = m.begin(); it != m.end(); it++ )
+		std::cout << keyOf( *it ) << " ";
+	std::cout << std::endl;
+}
+
+void nodeHandleTests( void ) {
+	std::cout << "NODE HANDLE TESTS:" << std::endl << std::endl;
+
+	// std gets extract and merge in C++17: the STL build erases and inserts copies instead
+	{
+		ft::map<int, std::string> a;
+		ft::map<int, std::string> b;
+		for ( int i = 0; i < 10; i++ )
+			a[i] = "a";
+		for ( int i = 5; i < 16; i++ )
+			b[i] = "b";
+		ft::pair<ft::map<int, std::string>::iterator, bool> res;
+		#ifndef STL_CONTAINERS
+			ft::map<int, std::string>::node_type nh = a.extract( 3 );
+			std::cout << nh.empty() << " " << nh.key() << " " << nh.mapped() << " " << a.size() << std::endl;
+			nh.key() = 30;
+			nh.mapped() = "moved";
+			res = b.insert( nh );
+			std::cout << res.second << " " << res.first->first << " " << res.first->second << " " << nh.empty() << std::endl;
+			nh = a.extract( a.find( 7 ) );
+			res = b.insert( nh );
+			std::cout << res.second << " " << res.first->second << " " << nh.empty() << " " << nh.key() << std::endl;
+			std::cout << a.extract( 42 ).empty() << " " << a.insert( a.extract( 42 ) ).second << std::endl;
+			a.insert( nh );
+			a.merge( b );
+		#else
+			std::pair<int, std::string> nh( 3, a[3] );
+			a.erase( 3 );
+			std::cout << false << " " << nh.first << " " << nh.second << " " << a.size() << std::endl;
+			nh.first = 30;
+			nh.second = "moved";
+			res = b.insert( nh );
+			std::cout << res.second << " " << res.first->first << " " << res.first->second << " " << true << std::endl;
+			nh = *a.find( 7 );
+			a.erase( 7 );
+			res = b.insert( nh );
+			std::cout << res.second << " " << res.first->second << " " << false << " " << nh.first << std::endl;
+			std::cout << true << " " << false << std::endl;
+			a.insert( nh );
+			for ( std::map<int, std::string>::iterator it = b.begin(); it != b.end(); ) {
+				if ( a.insert( *it ).second )
+					b.erase( it++ );
+				else
+					it++;
+			}
+		#endif
+		displayKeys( a );
+		displayKeys( b );
+		std::cout << a[30] << " " << a[12] << " " << a[7] << " " << b[7] << std::endl;
+	}
+	{
+		ft::set<int> a;
+		ft::set<int> b;
+		for ( int i = 0; i < 50; i++ ) {
+			a.insert( i * 3 );
+			b.insert( i * 2 );
+		}
+		#ifndef STL_CONTAINERS
+			ft::set<int>::node_type nh = b.extract( b.begin() );
+			nh.value() = 1;
+			a.insert( nh );
+			a.merge( b );
+		#else
+			b.erase( b.begin() );
+			a.insert( 1 );
+			for ( std::set<int>::iterator it = b.begin(); it != b.end(); ) {
+				if ( a.insert( *it ).second )
+					b.erase( it++ );
+				else
+					it++;
+			}
+		#endif
+		std::cout << a.size() << " " << b.size() << " " << *a.begin() << " " << *++a.begin() << " " << *a.rbegin() << std::endl;
+		displayKeys( b );
+	}
+	std::cout << "=======================================================" << std::endl;
+}
+
+void batchLookupTests( void ) {
+	std::cout << "BATCH LOOKUP TESTS:" << std::endl << std::endl;
+
+	// the STL build has no find_batch and looks the keys up one by one
+	{
+		ft::map<int, int> m;
+		for ( int i = 0; i < 1000; i++ )
+			m[i * 2] = i;
+		int keys[600];
+		for ( int i = 0; i < 600; i++ )
+			keys[i] = ( i * 7 ) % 2100 - 50;
+		ft::map<int, int>::iterator out[600];
+		#ifndef STL_CONTAINERS
+			m.find_batch( keys, 600, out );
+		#else
+			for ( int i = 0; i < 600; i++ )
+				out[i] = m.find( keys[i] );
+		#endif
+		int found = 0;
+		long sum = 0;
+		for ( int i = 0; i < 600; i++ ) {
+			if ( out[i] != m.end() ) {
+				found++;
+				sum += out[i]->second;
+				out[i]->second = -1;
+			}
+		}
+		std::cout << found << " " << sum << " " << m[keys[8]] << " " << ( out[0] == m.end() ) << std::endl;
+		const ft::map<int, int> c( m );
+		ft::map<int, int>::const_iterator hits[3];
+		#ifndef STL_CONTAINERS
+			c.find_batch( keys + 8, 3, hits );
+		#else
+			for ( int i = 0; i < 3; i++ )
+				hits[i] = c.find( keys[8 + i] );
+		#endif
+		for ( int i = 0; i < 3; i++ )
+			std::cout << ( hits[i] == c.end() ? "end" : "found" ) << " ";
+		std::cout << std::endl;
+		ft::map<int, int> empty;
+		#ifndef STL_CONTAINERS
+			empty.find_batch( keys, 2, out );
+		#else
+			for ( int i = 0; i < 2; i++ )
+				out[i] = empty.find( keys[i] );
+		#endif
+		std::cout << ( out[0] == empty.end() ) << " " << ( out[1] == empty.end() ) << std::endl;
+	}
+	{
+		ft::set<std::string> s;
+		s.insert( "b" );
+		s.insert( "d" );
+		s.insert( "f" );
+		std::string keys[] = { "a", "b", "c", "d", "e", "f", "g" };
+		ft::set<std::string>::iterator out[7];
+		#ifndef STL_CONTAINERS
+			s.find_batch( keys, 7, out );
+		#else
+			for ( int i = 0; i < 7; i++ )
+				out[i] = s.find( keys[i] );
+		#endif
+		for ( int i = 0; i < 7; i++ )
+			std::cout << ( out[i] == s.end() ? "-" : *out[i] ) << " ";
+		std::cout << std::endl;
+	}
+	std::cout << "=======================================================" << std::endl;
+}
+
+void sortedLookupTests( void ) {
+	std::cout << "SORTED LOOKUP TESTS:" << std::endl << std::endl;
+
+	// the STL build has no find_sorted and looks the keys up one by one
+	{
+		ft::map<int, std::string> m;
+		for ( int i = 0; i < 100; i += 4 )
+			m[i] = "v";
+		int keys[] = { -3, 0, 0, 3, 4, 8, 9, 40, 41, 44, 95, 96, 97, 200 };
+		ft::map<int, std::string>::iterator out[14];
+		#ifndef STL_CONTAINERS
+			ft::map<int, std::string>::iterator* last = m.find_sorted( keys, keys + 14, out );
+		#else
+			ft::map<int, std::string>::iterator* last = out;
+			for ( int i = 0; i < 14; i++ )
+				*last++ = m.find( keys[i] );
+		#endif
+		std::cout << ( last - out ) << ":";
+		for ( int i = 0; i < 14; i++ ) {
+			if ( out[i] == m.end() )
+				std::cout << " -";
+			else
+				std::cout << " " << out[i]->first;
+		}
+		std::cout << std::endl;
+		out[5]->second = "changed";
+		std::cout << m[8] << std::endl;
+	}
+	{
+		const ft::set<int> empty;
+		ft::vector<int> keys;
+		keys.push_back( 1 );
+		keys.push_back( 2 );
+		ft::vector< ft::set<int>::const_iterator > out( 2, empty.begin() );
+		#ifndef STL_CONTAINERS
+			empty.find_sorted( keys.begin(), keys.end(), out.begin() );
+		#else
+			for ( int i = 0; i < 2; i++ )
+				out[i] = empty.find( keys[i] );
+		#endif
+		std::cout << ( out[0] == empty.end() ) << " " << ( out[1] == empty.end() ) << std::endl;
+		ft::set<int> s;
+		for ( int i = 0; i < 1000; i++ )
+			s.insert( i * i % 997 );
+		keys.clear();
+		for ( int i = 0; i < 1000; i += 7 )
+			keys.push_back( i );
+		out.assign( keys.size(), s.end() );
+		#ifndef STL_CONTAINERS
+			s.find_sorted( keys.begin(), keys.end(), out.begin() );
+		#else
+			for ( size_t i = 0; i < keys.size(); i++ )
+				out[i] = s.find( keys[i] );
+		#endif
+		ft::set<int>::const_iterator last = s.end();
+		int found = 0;
+		for ( size_t i = 0; i < out.size(); i++ )
+			found += ( out[i] != last );
+		std::cout << s.size() << " " << keys.size() << " " << found << std::endl;
+	}
+	std::cout << "=======================================================" << std::endl;
+}
+
+// monoids for the aggregate tests
+struct valueSum {
+	typedef long result_type;
+	static result_type identity( void ) { return 0; }
+	static result_type lift( const ft::pair<const int, int>& v ) { return v.second; }
+	static result_type combine( result_type a, result_type b ) { return a + b; }
+};
+
+struct valueMin {
+	typedef int result_type;
+	static result_type identity( void ) { return 2147483647; }
+	static result_type lift( const ft::pair<const int, int>& v ) { return v.second; }
+	static result_type combine( result_type a, result_type b ) { return a < b ? a : b; }
+};
+
+// one letter per key, in order: combine is not commutative
+struct keyLetters {
+	typedef std::string result_type;
+	static result_type identity( void ) { return ""; }
+	static result_type lift( int v ) { return std::string( 1, 'a' + v % 26 ); }
+	static result_type combine( const result_type& a, const result_type& b ) { return a + b; }
+};
+
+// the STL build walks the range
+template <class Monoid, class M>
+typename Monoid::result_type rangeAggregate( const M& m, int lo, int hi ) {
+	#ifndef STL_CONTAINERS
+		return m.aggregate( lo, hi );
+	#else
+		typename Monoid::result_type res = Monoid::identity();
+		if ( lo < hi )
+			for ( typename M::const_iterator it = m.lower_bound( lo ); it != m.lower_bound( hi ); ++it )
+				res = Monoid::combine( res, Monoid::lift( *it ) );
+		return res;
+	#endif
+}
+
+void aggregateTests( void ) {
+	std::cout << "AGGREGATE TESTS:" << std::endl << std::endl;
+
+	#ifdef STL_CONTAINERS
+		typedef std::map<int, int> sum_map;
+		typedef std::map<int, int> min_map;
+		typedef std::set<int> letter_set;
+	#else
+		typedef ft::map<int, int, std::less<int>, std::allocator< ft::pair<const int, int> >, ft::aggregate_nodes<valueSum> > sum_map;
+		typedef ft::map<int, int, std::less<int>, std::allocator< ft::pair<const int, int> >, ft::aggregate_nodes<valueMin> > min_map;
+		typedef ft::set<int, std::less<int>, std::allocator<int>, ft::aggregate_nodes<keyLetters> > letter_set;
+	#endif
+	{
+		sum_map a;
+		min_map b;
+		for ( int i = 0; i < 200; i++ ) {
+			a.insert( ft::make_pair( i * 3, i * i % 97 ) );
+			b.insert( ft::make_pair( i * 3, i * i % 97 ) );
+		}
+		std::cout << rangeAggregate<valueSum>( a, 0, 600 ) << " " << rangeAggregate<valueSum>( a, 10, 100 ) << " ";
+		std::cout << rangeAggregate<valueSum>( a, 100, 10 ) << " " << rangeAggregate<valueSum>( a, 700, 800 ) << std::endl;
+		std::cout << rangeAggregate<valueMin>( b, 1, 30 ) << " " << rangeAggregate<valueMin>( b, 300, 450 ) << " ";
+		std::cout << rangeAggregate<valueMin>( b, 3, 4 ) << " " << rangeAggregate<valueMin>( b, 4, 5 ) << std::endl;
+		a[33] = 2000;
+		#ifndef STL_CONTAINERS
+			a.insert_or_assign( 30, 1000 );
+			a.refresh( a.find( 33 ) );
+		#else
+			a[30] = 1000;
+		#endif
+		a.erase( 36 );
+		a.erase( a.find( 300 ), a.find( 450 ) );
+		std::cout << rangeAggregate<valueSum>( a, 30, 40 ) << " " << rangeAggregate<valueSum>( a, 0, 1000 ) << std::endl;
+		// a hit of insert_or_assign is seen without refresh
+		#ifndef STL_CONTAINERS
+			a.insert_or_assign( 39, 500 );
+		#else
+			a[39] = 500;
+		#endif
+		std::cout << rangeAggregate<valueSum>( a, 39, 40 ) << " " << rangeAggregate<valueSum>( a, 0, 1000 ) << std::endl;
+		sum_map c( a );
+		c.erase( c.begin() );
+		a.swap( c );
+		std::cout << rangeAggregate<valueSum>( a, 0, 1000 ) << " " << rangeAggregate<valueSum>( c, 0, 1000 ) << std::endl;
+	}
+	{
+		letter_set s;
+		for ( int i = 25; i >= 0; i-- )
+			s.insert( i );
+		std::cout << rangeAggregate<keyLetters>( s, 0, 26 ) << " " << rangeAggregate<keyLetters>( s, 7, 12 ) << " ";
+		s.erase( 8 );
+		std::cout << rangeAggregate<keyLetters>( s, 7, 12 ) << "." << rangeAggregate<keyLetters>( s, 26, 0 ) << "." << std::endl;
+	}
+	std::cout << "=======================================================" << std::endl;
+}
+
+void intervalTests( void ) {
+	std::cout << "INTERVAL MAP TESTS:" << std::endl << std::endl;
+
+	// the STL build keeps the intervals in a map and scans all of them
+	#ifdef STL_CONTAINERS
+		typedef std::map< std::pair<int, int>, std::string > interval_map;
+	#else
+		typedef ft::interval_map< int, std::string > interval_map;
+	#endif
+	interval_map blocks;
+	blocks[ft::make_pair( 0, 256 )] = "a";
+	blocks[ft::make_pair( 10, 20 )] = "b";
+	blocks[ft::make_pair( 15, 16 )] = "c";
+	blocks[ft::make_pair( 100, 300 )] = "d";
+	blocks[ft::make_pair( 256, 512 )] = "e";
+	blocks[ft::make_pair( 600, 700 )] = "f";
+	blocks[ft::make_pair( 10, 12 )] = "g";
+	int queries[][2] = { { 15, 16 }, { 20, 100 }, { 256, 257 }, { 512, 600 }, { 0, 1000 }, { 700, 800 }, { -5, 0 } };
+	for ( int q = 0; q < 7; q++ ) {
+		int lo = queries[q][0];
+		int hi = queries[q][1];
+		std::cout << "[" << lo << ", " << hi << "):";
+		#ifndef STL_CONTAINERS
+			ft::pair<interval_map::query_iterator, interval_map::query_iterator> r = blocks.overlapping( lo, hi );
+			for ( ; r.first != r.second; ++r.first )
+				std::cout << " " << r.first->second;
+			std::cout << " " << blocks.overlaps( lo, hi );
+		#else
+			bool any = false;
+			for ( interval_map::iterator it = blocks.begin(); it != blocks.end(); ++it ) {
+				if ( it->first.first < hi && lo < it->first.second ) {
+					std::cout << " " << it->second;
+					any = true;
+				}
+			}
+			std::cout << " " << any;
+		#endif
+		std::cout << std::endl;
+	}
+	int points[] = { 0, 15, 255, 256, 599, 650, 700 };
+	for ( int p = 0; p < 7; p++ ) {
+		std::cout << points[p] << ":";
+		#ifndef STL_CONTAINERS
+			const interval_map& c = blocks;
+			ft::pair<interval_map::const_query_iterator, interval_map::const_query_iterator> r = c.stabbing( points[p] );
+			for ( ; r.first != r.second; r.first++ )
+				std::cout << " " << r.first->second;
+		#else
+			for ( interval_map::const_iterator it = blocks.begin(); it != blocks.end(); ++it )
+				if ( it->first.first <= points[p] && points[p] < it->first.second )
+					std::cout << " " << it->second;
+		#endif
+		std::cout << std::endl;
+	}
+	blocks.erase( ft::make_pair( 0, 256 ) );
+	#ifndef STL_CONTAINERS
+		blocks.insert( 250, 260, "h" );
+		blocks.overlapping( 600, 601 ).first->second = "F";
+	#else
+		blocks[std::make_pair( 250, 260 )] = "h";
+		blocks[std::make_pair( 600, 700 )] = "F";
+	#endif
+	interval_map copy( blocks );
+	for ( interval_map::iterator it = copy.begin(); it != copy.end(); ++it )
+		std::cout << "[" << it->first.first << ", " << it->first.second << ") " << it->second << " ";
+	std::cout << std::endl << copy.size() << " " << copy.count( ft::make_pair( 10, 20 ) ) << " " << copy.count( ft::make_pair( 10, 21 ) ) << std::endl;
+	{
+		// a function pointer comparator orders the ends of the nodes too
+		#ifdef STL_CONTAINERS
+			typedef std::map< std::pair<int, int>, int > fn_map;
+			fn_map spans;
+		#else
+			typedef ft::interval_map< int, int, bool (*)( int, int ) > fn_map;
+			fn_map spans( boundLess );
+		#endif
+		for ( int i = 0; i < 40; i++ ) {
+			#ifndef STL_CONTAINERS
+				spans.insert( i * 5, i * 5 + ( i % 7 ) * 10 + 1, i );
+			#else
+				spans[std::make_pair( i * 5, i * 5 + ( i % 7 ) * 10 + 1 )] = i;
+			#endif
+		}
+		int stabs[] = { 0, 33, 100, 199, 250 };
+		for ( int p = 0; p < 5; p++ ) {
+			std::cout << stabs[p] << ":";
+			#ifndef STL_CONTAINERS
+				ft::pair<fn_map::query_iterator, fn_map::query_iterator> r = spans.stabbing( stabs[p] );
+				for ( ; r.first != r.second; ++r.first )
+					std::cout << " " << r.first->second;
+			#else
+				for ( fn_map::iterator it = spans.begin(); it != spans.end(); ++it )
+					if ( it->first.first <= stabs[p] && stabs[p] < it->first.second )
+						std::cout << " " << it->second;
+			#endif
+			std::cout << std::endl;
+		}
+	}
+	std::cout << "=======================================================" << std::endl;
+}
+
 void hardTest( void ) {
 	ft::set<int> a;
 	size_t big_num = 20000000;
@@ -2465,6 +3741,48 @@ int	main(void) {
 	setModifiersTests();
 	setOperationsTests();
 
+	// Allocator Tests
+	poolAllocatorTests();
+
+	// Augmentation Tests
+	orderStatisticsTests();
+
+	// Set Algebra Tests
+	setAlgebraTests();
+
+	// Multi container Tests
+	multiTests();
+
+	// B-tree Tests
+	btreeTests();
+
+	// Flat container Tests
+	flatTests();
+
+	// Hash container Tests
+	unorderedTests();
+
+	// Concurrent map Tests
+	concurrentTests();
+
+	// Persistent map Tests
+	persistentTests();
+
+	// Node handle Tests
+	nodeHandleTests();
+
+	// Batch lookup Tests
+	batchLookupTests();
+
+	// Sorted lookup Tests
+	sortedLookupTests();
+
+	// Aggregate Tests
+	aggregateTests();
+
+	// Interval map Tests
+	intervalTests();
+
 	hardTest();
 
 	gettimeofday( &timer, NULL );